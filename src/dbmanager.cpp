@@ -1,4 +1,6 @@
 #include "dbmanager.h"
+#include "startupsnapshot.h"
+#include "startuptrace.h"
 #include <QtSql/QSqlQuery>
 #include <QTimeZone>
 #include <QDateTime>
@@ -7,16 +9,67 @@
 #include <QtConcurrent>
 #include <QSqlRecord>
 #include <QSet>
+#include <QFileInfo>
 #include <algorithm>
 
 #define DEFAULT_DATABASE_NAME "default_database"
 #define OUTSIDE_DATABASE_NAME "outside_database"
 
+// Note bodies at least this large (in UTF-8 bytes) are stored zlib-compressed
+#define COMPRESSED_CONTENT_THRESHOLD 16384
+#define COMPRESSED_CONTENT_HEADER '\x01'
+#define COMPRESSED_CONTENT_REENCODE_BATCH 32
+// The trigram tokenizer can't match keywords shorter than this
+#define SEARCH_INDEX_MIN_KEYWORD_LENGTH 3
+
+/*!
+ * \brief encodeNoteContent
+ * Small bodies are kept as plain TEXT. Large ones are stored as a BLOB made of
+ * a one byte header followed by the qCompress() output of the UTF-8 text
+ * \param content
+ * \return
+ */
+static QVariant encodeNoteContent(const QString &content)
+{
+    QByteArray utf8 = content.toUtf8();
+    if (utf8.size() < COMPRESSED_CONTENT_THRESHOLD) {
+        return content;
+    }
+    QByteArray blob = qCompress(utf8);
+    if (blob.size() + 1 >= utf8.size()) {
+        return content;
+    }
+    blob.prepend(COMPRESSED_CONTENT_HEADER);
+    return blob;
+}
+
+/*!
+ * \brief decodeNoteContent
+ * Reverse of encodeNoteContent, plain TEXT values are returned untouched
+ * \param value
+ * \return
+ */
+static QString decodeNoteContent(const QVariant &value)
+{
+    if (value.typeId() == QMetaType::QByteArray) {
+        QByteArray blob = value.toByteArray();
+        if (!blob.isEmpty() && blob.at(0) == COMPRESSED_CONTENT_HEADER) {
+            QByteArray utf8 = qUncompress(reinterpret_cast<const uchar *>(blob.constData()) + 1, blob.size() - 1);
+            if (utf8.isEmpty() && blob.size() > 1) {
+                qDebug() << __FUNCTION__ << "Failed to decompress note content";
+            }
+            return QString::fromUtf8(utf8);
+        }
+        return QString::fromUtf8(blob);
+    }
+    return value.toString();
+}
+
 /*!
  * \brief DBManager::DBManager
  * \param parent
  */
-DBManager::DBManager(QObject *parent) : QObject(parent)
+DBManager::DBManager(QObject *parent) : QObject(parent), m_hasSearchIndex(false), m_canDeleteFromSearchIndex(false)
 {
     qRegisterMetaType<QList<NodeData *>>("QList<NodeData*>");
     qRegisterMetaType<QVector<NodeData>>("QVector<NodeData>");
@@ -24,6 +77,7 @@ DBManager::DBManager(QObject *parent) : QObject(parent)
     qRegisterMetaType<QSet<int>>("QSet<int>");
     qRegisterMetaType<ListViewInfo>("ListViewInfo");
     qRegisterMetaType<FolderListType>("DBManager::FolderListType");
+    qRegisterMetaType<NoteContentMap>("NoteContentMap");
 }
 
 /*!
@@ -41,11 +95,16 @@ void DBManager::open(const QString &path, bool doCreate)
     } else {
         qDebug() << "Database: connection ok";
     }
+    StartupTrace::instance()->markOnce(QStringLiteral("database opened"));
 
     if (doCreate) {
         createTables();
     }
+    migrateDisplayColumns();
+    createSearchIndex();
     recalculateChildNotesCount();
+    StartupTrace::instance()->markOnce(QStringLiteral("child notes recounted"));
+    QMetaObject::invokeMethod(this, "reencodeNoteContent", Qt::QueuedConnection, Q_ARG(int, INVALID_NODE_ID));
 }
 
 /*!
@@ -73,7 +132,9 @@ void DBManager::createTables()
                         R"(    "absolute_path"	TEXT NOT NULL,)"
                         R"(    "is_pinned_note"	INTEGER NOT NULL DEFAULT 0,)"
                         R"(    "relative_position_an"	INTEGER NOT NULL,)"
-                        R"(    "child_notes_count"	INTEGER NOT NULL)"
+                        R"(    "child_notes_count"	INTEGER NOT NULL,)"
+                        R"(    "display_title"	TEXT,)"
+                        R"(    "preview"	TEXT)"
                         R"();)";
     auto status = query.exec(nodeTable);
     if (!status) {
@@ -161,6 +222,222 @@ void DBManager::createTables()
     }
 }
 
+/*!
+ * \brief DBManager::migrateDisplayColumns
+ * Databases created before the display_title and preview columns existed get
+ * them added here, then every note is backfilled once
+ */
+void DBManager::migrateDisplayColumns()
+{
+    if (m_db.record(QStringLiteral("node_table")).contains(QStringLiteral("preview"))) {
+        return;
+    }
+    if (!m_db.transaction()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    QSqlQuery query(m_db);
+    if (!query.exec(R"(ALTER TABLE "node_table" ADD COLUMN "display_title" TEXT;)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (!query.exec(R"(ALTER TABLE "node_table" ADD COLUMN "preview" TEXT;)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (!query.prepare(R"(SELECT "id", "title", "content", "node_type" FROM node_table;)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    QSqlQuery updateQuery(m_db);
+    if (!updateQuery.prepare(R"(UPDATE node_table SET display_title = :display_title, preview = :preview WHERE id = :id;)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << updateQuery.lastError();
+    }
+    if (query.exec()) {
+        while (query.next()) {
+            bool isNote = static_cast<NodeData::Type>(query.value(3).toInt()) == NodeData::Type::Note;
+            updateQuery.bindValue(QStringLiteral(":display_title"), NodeData::getDisplayTitle(query.value(1).toString()));
+            updateQuery.bindValue(QStringLiteral(":preview"), isNote ? NodeData::getSecondLine(decodeNoteContent(query.value(2))) : QString());
+            updateQuery.bindValue(QStringLiteral(":id"), query.value(0).toInt());
+            if (!updateQuery.exec()) {
+                qDebug() << __FUNCTION__ << __LINE__ << updateQuery.lastError();
+            }
+        }
+    } else {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (!m_db.commit()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+}
+
+/*!
+ * \brief DBManager::createSearchIndex
+ * LIKE can't look inside compressed bodies, so those are tokenized into the
+ * contentless FTS5 table note_search instead. Being contentless, it keeps no
+ * copy of the text. Bodies stored as TEXT are still searched in place
+ */
+void DBManager::createSearchIndex()
+{
+    m_hasSearchIndex = false;
+    m_canDeleteFromSearchIndex = false;
+    QSqlQuery query(m_db);
+    if (!query.prepare(R"(SELECT sql FROM sqlite_master WHERE type = 'table' AND name = 'note_search';)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (query.next()) {
+        m_hasSearchIndex = true;
+        m_canDeleteFromSearchIndex = query.value(0).toString().contains(QStringLiteral("contentless_delete"));
+        return;
+    }
+    query.finish();
+
+    // contentless_delete needs SQLite 3.43, older versions can only delete a
+    // row by handing back the text it was indexed with
+    if (query.exec(R"(CREATE VIRTUAL TABLE "note_search" USING fts5(content, content='', contentless_delete=1, tokenize='trigram');)")) {
+        m_canDeleteFromSearchIndex = true;
+    } else if (!query.exec(R"(CREATE VIRTUAL TABLE "note_search" USING fts5(content, content='', tokenize='trigram');)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        return;
+    }
+    m_hasSearchIndex = true;
+
+    // the search_content column this index replaces held a second plain copy
+    // of every compressed body
+    if (m_db.record(QStringLiteral("node_table")).contains(QStringLiteral("search_content"))
+        && !query.exec(R"(ALTER TABLE "node_table" DROP COLUMN "search_content";)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (!m_db.transaction()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    if (!query.prepare(R"(SELECT "id", "content" FROM node_table WHERE typeof(content) = 'blob' AND node_type = :node_type;)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
+    if (query.exec()) {
+        while (query.next()) {
+            addToSearchIndex(query.value(0).toInt(), query.value(1), decodeNoteContent(query.value(1)));
+        }
+    } else {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (!m_db.commit()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+}
+
+/*!
+ * \brief DBManager::addToSearchIndex
+ * Only bodies that encodeNoteContent compressed are indexed
+ * \param noteId
+ * \param encodedContent the value stored in the content column
+ * \param content the plain text it was encoded from
+ */
+void DBManager::addToSearchIndex(int noteId, const QVariant &encodedContent, const QString &content)
+{
+    if (!m_hasSearchIndex || encodedContent.typeId() != QMetaType::QByteArray) {
+        return;
+    }
+    QSqlQuery query(m_db);
+    if (!query.prepare(R"(INSERT INTO "note_search"(rowid, content) VALUES (:id, :content);)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":id"), noteId);
+    query.bindValue(QStringLiteral(":content"), content);
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+}
+
+/*!
+ * \brief DBManager::removeFromSearchIndex
+ * Has to run before the note's content column is overwritten or deleted,
+ * since without contentless_delete the old text is read back from there
+ * \param noteId
+ */
+void DBManager::removeFromSearchIndex(int noteId)
+{
+    if (!m_hasSearchIndex) {
+        return;
+    }
+    QSqlQuery query(m_db);
+    if (m_canDeleteFromSearchIndex) {
+        if (!query.prepare(R"(DELETE FROM "note_search" WHERE rowid = :id;)")) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+        query.bindValue(QStringLiteral(":id"), noteId);
+        if (!query.exec()) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+        return;
+    }
+    if (!query.prepare(R"(SELECT "content" FROM node_table WHERE id = :id AND typeof(content) = 'blob';)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":id"), noteId);
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (!query.next()) {
+        return;
+    }
+    QString content = decodeNoteContent(query.value(0));
+    query.finish();
+    if (!query.prepare(R"(INSERT INTO "note_search"("note_search", rowid, content) VALUES ('delete', :id, :content);)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":id"), noteId);
+    query.bindValue(QStringLiteral(":content"), content);
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+}
+
+/*!
+ * \brief DBManager::contentSearchCondition
+ * WHERE clause fragment matching the notes whose body contains keyword, the
+ * caller binds keyword to :search_expr. Compressed bodies are looked up in
+ * note_search, or decoded here when the keyword is too short for the trigram
+ * tokenizer or the index couldn't be created
+ * \param keyword
+ * \return
+ */
+QString DBManager::contentSearchCondition(const QString &keyword)
+{
+    QStringList compressedIds;
+    QSqlQuery query(m_db);
+    if (m_hasSearchIndex && keyword.size() >= SEARCH_INDEX_MIN_KEYWORD_LENGTH) {
+        if (!query.prepare(R"(SELECT rowid FROM "note_search" WHERE "note_search" MATCH :phrase;)")) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+        QString phrase = keyword;
+        phrase.replace(QChar('"'), QStringLiteral("\"\""));
+        query.bindValue(QStringLiteral(":phrase"), QChar('"') + phrase + QChar('"'));
+        if (query.exec()) {
+            while (query.next()) {
+                compressedIds.append(QString::number(query.value(0).toInt()));
+            }
+        } else {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+    } else {
+        if (!query.prepare(R"(SELECT "id", "content" FROM node_table WHERE typeof(content) = 'blob' AND node_type = :node_type;)")) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+        query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
+        if (query.exec()) {
+            while (query.next()) {
+                if (decodeNoteContent(query.value(1)).contains(keyword, Qt::CaseInsensitive)) {
+                    compressedIds.append(QString::number(query.value(0).toInt()));
+                }
+            }
+        } else {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+    }
+    return QStringLiteral("((typeof(content) = 'text' AND content like '%' || (:search_expr) || '%') OR id IN (%1))").arg(compressedIds.join(QLatin1Char(',')));
+}
+
 /*!
  * \brief DBManager::isNoteExist
  * \param note
@@ -213,10 +490,10 @@ QVector<NodeData> DBManager::getAllFolders()
             NodeData node;
             node.setId(query.value(0).toInt());
             node.setFullTitle(query.value(1).toString());
-            node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(2).toLongLong()));
-            node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(3).toLongLong()));
-            node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(query.value(4).toLongLong()));
-            node.setContent(query.value(5).toString());
+            node.setCreationTime(query.value(2).toLongLong());
+            node.setLastModificationTime(query.value(3).toLongLong());
+            node.setDeletionTime(query.value(4).toLongLong());
+            node.setContent(decodeNoteContent(query.value(5)));
             node.setNodeType(static_cast<NodeData::Type>(query.value(6).toInt()));
             node.setParentId(query.value(7).toInt());
             node.setRelativePosition(query.value(8).toInt());
@@ -284,14 +561,14 @@ int DBManager::addNode(const NodeData &node)
     QSqlQuery query(m_db);
     QString emptyStr;
 
-    qint64 epochTimeDateCreated = node.creationDateTime().toMSecsSinceEpoch();
+    qint64 epochTimeDateCreated = node.creationTime() == INVALID_TIME ? 0 : node.creationTime();
     QString content = node.content();
     content.replace("'", "''").replace(QChar('\x0'), emptyStr);
 
     QString fullTitle = node.fullTitle();
     fullTitle.replace("'", "''").replace(QChar('\x0'), emptyStr);
 
-    qint64 epochTimeDateLastModified = node.lastModificationdateTime().isNull() ? epochTimeDateCreated : node.lastModificationdateTime().toMSecsSinceEpoch();
+    qint64 epochTimeDateLastModified = node.lastModificationTime() == INVALID_TIME ? epochTimeDateCreated : node.lastModificationTime();
 
     int relationalPosition = 0;
     if (node.parentId() != -1) {
@@ -321,8 +598,8 @@ int DBManager::addNode(const NodeData &node)
     absolutePath += PATH_SEPARATOR + QString::number(nodeId);
     QString queryStr =
             R"(INSERT INTO "node_table")"
-            R"(("id", "title", "creation_date", "modification_date", "deletion_date", "content", "node_type", "parent_id", "relative_position", "scrollbar_position", "absolute_path", "is_pinned_note", "relative_position_an", "child_notes_count"))"
-            R"(VALUES (:id, :title, :creation_date, :modification_date, :deletion_date, :content, :node_type, :parent_id, :relative_position, :scrollbar_position, :absolute_path, :is_pinned_note, :relative_position_an, :child_notes_count);)";
+            R"(("id", "title", "creation_date", "modification_date", "deletion_date", "content", "node_type", "parent_id", "relative_position", "scrollbar_position", "absolute_path", "is_pinned_note", "relative_position_an", "child_notes_count", "display_title", "preview"))"
+            R"(VALUES (:id, :title, :creation_date, :modification_date, :deletion_date, :content, :node_type, :parent_id, :relative_position, :scrollbar_position, :absolute_path, :is_pinned_note, :relative_position_an, :child_notes_count, :display_title, :preview);)";
 
     if (!query.prepare(queryStr)) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
@@ -331,12 +608,13 @@ int DBManager::addNode(const NodeData &node)
     query.bindValue(":title", fullTitle);
     query.bindValue(":creation_date", epochTimeDateCreated);
     query.bindValue(":modification_date", epochTimeDateLastModified);
-    if (node.deletionDateTime().isNull()) {
+    if (node.deletionTime() == INVALID_TIME) {
         query.bindValue(":deletion_date", -1);
     } else {
-        query.bindValue(":deletion_date", node.deletionDateTime().toMSecsSinceEpoch());
+        query.bindValue(":deletion_date", node.deletionTime());
     }
-    query.bindValue(":content", content);
+    auto encodedContent = encodeNoteContent(content);
+    query.bindValue(":content", encodedContent);
     query.bindValue(":node_type", static_cast<int>(node.nodeType()));
     query.bindValue(":parent_id", node.parentId());
     query.bindValue(":relative_position", relationalPosition);
@@ -345,11 +623,14 @@ int DBManager::addNode(const NodeData &node)
     query.bindValue(":is_pinned_note", node.isPinnedNote() ? 1 : 0);
     query.bindValue(":relative_position_an", node.relativePosAN());
     query.bindValue(":child_notes_count", node.childNotesCount());
+    query.bindValue(":display_title", NodeData::getDisplayTitle(node.fullTitle()));
+    query.bindValue(":preview", node.nodeType() == NodeData::Type::Note ? NodeData::getSecondLine(node.content()) : QString());
 
     if (!query.exec()) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
     query.finish();
+    addToSearchIndex(nodeId, encodedContent, content);
 
     if (!query.prepare(R"(UPDATE "metadata" SET "value"=:value WHERE "key"='next_node_id';)")) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
@@ -370,20 +651,20 @@ int DBManager::addNodePreComputed(const NodeData &node)
     QSqlQuery query(m_db);
     QString emptyStr;
 
-    qint64 epochTimeDateCreated = node.creationDateTime().toMSecsSinceEpoch();
+    qint64 epochTimeDateCreated = node.creationTime() == INVALID_TIME ? 0 : node.creationTime();
     QString content = node.content();
     content.replace("'", "''").replace(QChar('\x0'), emptyStr);
     QString fullTitle = node.fullTitle();
     fullTitle.replace("'", "''").replace(QChar('\x0'), emptyStr);
 
-    qint64 epochTimeDateLastModified = node.lastModificationdateTime().isNull() ? epochTimeDateCreated : node.lastModificationdateTime().toMSecsSinceEpoch();
+    qint64 epochTimeDateLastModified = node.lastModificationTime() == INVALID_TIME ? epochTimeDateCreated : node.lastModificationTime();
 
     int relationalPosition = node.relativePosition();
     int nodeId = node.id();
     QString queryStr =
             R"(INSERT INTO "node_table" )"
-            R"(("id", "title", "creation_date", "modification_date", "deletion_date", "content", "node_type", "parent_id", "relative_position", "scrollbar_position", "absolute_path", "is_pinned_note", "relative_position_an", "child_notes_count") )"
-            R"(VALUES (:id, :title, :creation_date, :modification_date, :deletion_date, :content, :node_type, :parent_id, :relative_position, :scrollbar_position, :absolute_path, :is_pinned_note, :relative_position_an, :child_notes_count);)";
+            R"(("id", "title", "creation_date", "modification_date", "deletion_date", "content", "node_type", "parent_id", "relative_position", "scrollbar_position", "absolute_path", "is_pinned_note", "relative_position_an", "child_notes_count", "display_title", "preview") )"
+            R"(VALUES (:id, :title, :creation_date, :modification_date, :deletion_date, :content, :node_type, :parent_id, :relative_position, :scrollbar_position, :absolute_path, :is_pinned_note, :relative_position_an, :child_notes_count, :display_title, :preview);)";
 
     if (!query.prepare(queryStr)) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
@@ -392,12 +673,13 @@ int DBManager::addNodePreComputed(const NodeData &node)
     query.bindValue(":title", fullTitle);
     query.bindValue(":creation_date", epochTimeDateCreated);
     query.bindValue(":modification_date", epochTimeDateLastModified);
-    if (node.deletionDateTime().isNull()) {
+    if (node.deletionTime() == INVALID_TIME) {
         query.bindValue(":deletion_date", -1);
     } else {
-        query.bindValue(":deletion_date", node.deletionDateTime().toMSecsSinceEpoch());
+        query.bindValue(":deletion_date", node.deletionTime());
     }
-    query.bindValue(":content", content);
+    auto encodedContent = encodeNoteContent(content);
+    query.bindValue(":content", encodedContent);
     query.bindValue(":node_type", static_cast<int>(node.nodeType()));
     query.bindValue(":parent_id", node.parentId());
     query.bindValue(":relative_position", relationalPosition);
@@ -406,6 +688,8 @@ int DBManager::addNodePreComputed(const NodeData &node)
     query.bindValue(":is_pinned_note", node.isPinnedNote() ? 1 : 0);
     query.bindValue(":relative_position_an", node.relativePosAN());
     query.bindValue(":child_notes_count", node.childNotesCount());
+    query.bindValue(":display_title", NodeData::getDisplayTitle(node.fullTitle()));
+    query.bindValue(":preview", node.nodeType() == NodeData::Type::Note ? NodeData::getSecondLine(node.content()) : QString());
 
     bool status = query.exec();
     if (!status) {
@@ -413,6 +697,7 @@ int DBManager::addNodePreComputed(const NodeData &node)
     }
 
     query.finish();
+    addToSearchIndex(nodeId, encodedContent, content);
 
     return nodeId;
 }
@@ -503,7 +788,7 @@ void DBManager::recalculateChildNotesCount()
         if (!status) {
             qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
         }
-        emit childNotesCountUpdatedFolder(id, folderIds[id], childNotesCount);
+        emit childNotesCountUpdatedFolder(id, childNotesCount);
     }
     recalculateChildNotesCountAllNotes();
 }
@@ -536,7 +821,7 @@ void DBManager::recalculateChildNotesCountFolder(int folderId)
     if (!status) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
-    emit childNotesCountUpdatedFolder(folderId, getNodeAbsolutePath(folderId).path(), childNotesCount);
+    emit childNotesCountUpdatedFolder(folderId, childNotesCount);
 }
 
 void DBManager::recalculateChildNotesCountTag(int tagId)
@@ -596,7 +881,7 @@ void DBManager::recalculateChildNotesCountAllNotes()
     if (!status) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
-    emit childNotesCountUpdatedFolder(ROOT_FOLDER_ID, getNodeAbsolutePath(ROOT_FOLDER_ID).path(), childNotesCount);
+    emit childNotesCountUpdatedFolder(ROOT_FOLDER_ID, childNotesCount);
 }
 
 void DBManager::increaseChildNotesCountTag(int tagId)
@@ -667,17 +952,15 @@ void DBManager::decreaseChildNotesCountTag(int tagId)
 void DBManager::increaseChildNotesCountFolder(int folderId)
 {
     QSqlQuery query(m_db);
-    if (!query.prepare(R"(SELECT child_notes_count, absolute_path  FROM "node_table" WHERE id=:id)")) {
+    if (!query.prepare(R"(SELECT child_notes_count FROM "node_table" WHERE id=:id)")) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
     query.bindValue(QStringLiteral(":id"), folderId);
     bool status = query.exec();
     int childNotesCount = 0;
-    QString absPath;
     if (status) {
         query.next();
         childNotesCount = query.value(0).toInt();
-        absPath = query.value(1).toString();
     } else {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
         return;
@@ -695,23 +978,21 @@ void DBManager::increaseChildNotesCountFolder(int folderId)
     if (!status) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
-    emit childNotesCountUpdatedFolder(folderId, absPath, childNotesCount);
+    emit childNotesCountUpdatedFolder(folderId, childNotesCount);
 }
 
 void DBManager::decreaseChildNotesCountFolder(int folderId)
 {
     QSqlQuery query(m_db);
-    if (!query.prepare(R"(SELECT child_notes_count, absolute_path  FROM "node_table" WHERE id=:id)")) {
+    if (!query.prepare(R"(SELECT child_notes_count FROM "node_table" WHERE id=:id)")) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
     query.bindValue(QStringLiteral(":id"), folderId);
     bool status = query.exec();
     int childNotesCount = 0;
-    QString absPath;
     if (status) {
         query.next();
         childNotesCount = query.value(0).toInt();
-        absPath = query.value(1).toString();
     } else {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
         return;
@@ -730,7 +1011,32 @@ void DBManager::decreaseChildNotesCountFolder(int folderId)
     if (!status) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
-    emit childNotesCountUpdatedFolder(folderId, absPath, childNotesCount);
+    emit childNotesCountUpdatedFolder(folderId, childNotesCount);
+}
+
+void DBManager::changeChildNotesCountTag(int tagId, int delta)
+{
+    QSqlQuery query(m_db);
+    if (!query.prepare(QStringLiteral("UPDATE tag_table SET child_notes_count = max(child_notes_count + :delta, 0) "
+                                      "WHERE id = :id"))) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":id"), tagId);
+    query.bindValue(QStringLiteral(":delta"), delta);
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        return;
+    }
+    query.clear();
+    if (!query.prepare(R"(SELECT child_notes_count FROM "tag_table" WHERE id=:id)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":id"), tagId);
+    if (query.exec() && query.next()) {
+        emit childNotesCountUpdatedTag(tagId, query.value(0).toInt());
+    } else {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
 }
 
 int DBManager::addTag(const TagData &tag)
@@ -812,6 +1118,65 @@ void DBManager::removeNoteFromTag(int noteId, int tagId)
     decreaseChildNotesCountTag(tagId);
 }
 
+/*!
+ * \brief DBManager::addNotesToTag
+ * Bulk version of addNoteToTag, runs in one transaction and updates the tag
+ * count once
+ */
+void DBManager::addNotesToTag(const QSet<int> &noteIds, int tagId)
+{
+    if (noteIds.isEmpty()) {
+        return;
+    }
+    if (!m_db.transaction()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    QSqlQuery query(m_db);
+    if (!query.prepare(R"(INSERT OR IGNORE INTO "tag_relationship" ("node_id","tag_id") VALUES (:note_id, :tag_id);)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    for (const auto noteId : noteIds) {
+        query.bindValue(":note_id", noteId);
+        query.bindValue(":tag_id", tagId);
+        if (!query.exec()) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+    }
+    if (!m_db.commit()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    recalculateChildNotesCountTag(tagId);
+}
+
+void DBManager::removeNotesFromTag(const QSet<int> &noteIds, int tagId)
+{
+    if (noteIds.isEmpty()) {
+        return;
+    }
+    if (!m_db.transaction()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    QSqlQuery query(m_db);
+    if (!query.prepare(R"(DELETE FROM "tag_relationship" )"
+                       R"(WHERE node_id = (:note_id) AND tag_id = (:tag_id);)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    int removedCount = 0;
+    for (const auto noteId : noteIds) {
+        query.bindValue(":note_id", noteId);
+        query.bindValue(":tag_id", tagId);
+        if (query.exec()) {
+            removedCount += std::max(query.numRowsAffected(), 0);
+        } else {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+    }
+    if (!m_db.commit()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    changeChildNotesCountTag(tagId, -removedCount);
+}
+
 int DBManager::nextAvailableNodeId()
 {
     QSqlQuery query(m_db);
@@ -891,6 +1256,7 @@ void DBManager::changeTagColor(int id, const QString &newColor)
 void DBManager::removeNote(const NodeData &note)
 {
     if (note.parentId() == TRASH_FOLDER_ID) {
+        removeFromSearchIndex(note.id());
         QSqlQuery query(m_db);
         if (!query.prepare(R"(DELETE FROM "node_table" )"
                            R"(WHERE id = (:id) AND node_type = (:node_type);)")) {
@@ -919,6 +1285,188 @@ void DBManager::removeNote(const NodeData &note)
     }
 }
 
+/*!
+ * \brief DBManager::removeNotes
+ * Bulk version of removeNote: notes already in Trash are deleted, the others
+ * are moved to Trash. Each group runs in one transaction and the affected
+ * counts are updated once per folder and tag instead of once per note.
+ * \param noteIds
+ */
+void DBManager::removeNotes(const QSet<int> &noteIds)
+{
+    const auto noteParentIds = getNoteParentIds(noteIds);
+    QSet<int> trashedIds;
+    QHash<int, int> otherParentIds;
+    for (auto it = noteParentIds.constBegin(); it != noteParentIds.constEnd(); ++it) {
+        if (it.value() == TRASH_FOLDER_ID) {
+            trashedIds.insert(it.key());
+        } else {
+            otherParentIds.insert(it.key(), it.value());
+        }
+    }
+    if (!trashedIds.isEmpty()) {
+        if (!m_db.transaction()) {
+            qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+        }
+        QSqlQuery deleteNode(m_db);
+        if (!deleteNode.prepare(R"(DELETE FROM "node_table" )"
+                                R"(WHERE id = (:id) AND node_type = (:node_type);)")) {
+            qDebug() << __FUNCTION__ << __LINE__ << deleteNode.lastError();
+        }
+        QSqlQuery deleteRelationship(m_db);
+        if (!deleteRelationship.prepare(R"(DELETE FROM "tag_relationship" )"
+                                        R"(WHERE node_id = (:id);)")) {
+            qDebug() << __FUNCTION__ << __LINE__ << deleteRelationship.lastError();
+        }
+        for (const auto id : std::as_const(trashedIds)) {
+            removeFromSearchIndex(id);
+            deleteNode.bindValue(QStringLiteral(":id"), id);
+            deleteNode.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
+            if (!deleteNode.exec()) {
+                qDebug() << __FUNCTION__ << __LINE__ << deleteNode.lastError();
+            }
+            deleteRelationship.bindValue(QStringLiteral(":id"), id);
+            if (!deleteRelationship.exec()) {
+                qDebug() << __FUNCTION__ << __LINE__ << deleteRelationship.lastError();
+            }
+        }
+        if (!m_db.commit()) {
+            qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+        }
+        recalculateChildNotesCountFolder(TRASH_FOLDER_ID);
+    }
+    if (!otherParentIds.isEmpty()) {
+        moveNotesFromParents(otherParentIds, TRASH_FOLDER_ID);
+    }
+}
+
+/*!
+ * \brief DBManager::getNoteParentIds
+ * Maps each of noteIds that is a note to its parent folder in one query,
+ * without loading the bodies like getNode does
+ * \param noteIds
+ * \return
+ */
+QHash<int, int> DBManager::getNoteParentIds(const QSet<int> &noteIds)
+{
+    QHash<int, int> parentIds;
+    if (noteIds.isEmpty()) {
+        return parentIds;
+    }
+    QStringList idList;
+    idList.reserve(noteIds.size());
+    for (const auto id : noteIds) {
+        idList.append(QString::number(id));
+    }
+    QSqlQuery query(m_db);
+    if (!query.prepare(QStringLiteral(R"(SELECT "id", "parent_id" FROM node_table WHERE id IN (%1) AND node_type = (:node_type);)")
+                               .arg(idList.join(QLatin1Char(','))))) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        return parentIds;
+    }
+    parentIds.reserve(noteIds.size());
+    while (query.next()) {
+        parentIds.insert(query.value(0).toInt(), query.value(1).toInt());
+    }
+    return parentIds;
+}
+
+/*!
+ * \brief DBManager::moveNotes
+ * Bulk version of moveNode for notes
+ * \param noteIds
+ * \param targetId
+ */
+void DBManager::moveNotes(const QSet<int> &noteIds, int targetId)
+{
+    moveNotesFromParents(getNoteParentIds(noteIds), targetId);
+}
+
+/*!
+ * \brief DBManager::moveNotesFromParents
+ * Moves the notes of noteParentIds (note id -> current parent id, as
+ * returned by getNoteParentIds) into the folder targetId
+ * \param noteParentIds
+ * \param targetId
+ */
+void DBManager::moveNotesFromParents(const QHash<int, int> &noteParentIds, int targetId)
+{
+    auto target = getNode(targetId);
+    if (target.nodeType() != NodeData::Type::Folder) {
+        qDebug() << "moveNotes target is not folder" << targetId;
+        return;
+    }
+    if (!m_db.transaction()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    QSqlQuery query(m_db);
+    if (targetId == TRASH_FOLDER_ID) {
+        if (!query.prepare(QStringLiteral("UPDATE node_table SET parent_id = :parent_id, absolute_path = :absolute_path, "
+                                          "is_pinned_note = :is_pinned_note, deletion_date = :deletion_date "
+                                          "WHERE id = :id AND node_type = :node_type;"))) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+    } else {
+        if (!query.prepare(QStringLiteral("UPDATE node_table SET parent_id = :parent_id, absolute_path = :absolute_path "
+                                          "WHERE id = :id AND node_type = :node_type;"))) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+    }
+    qint64 deletionTime = QDateTime::currentMSecsSinceEpoch();
+    QSet<int> affectedFolders{ targetId };
+    QHash<int, int> tagCountChanges;
+    for (auto it = noteParentIds.constBegin(); it != noteParentIds.constEnd(); ++it) {
+        const int id = it.key();
+        const int parentId = it.value();
+        if (parentId == targetId) {
+            continue;
+        }
+        query.bindValue(QStringLiteral(":parent_id"), targetId);
+        query.bindValue(QStringLiteral(":absolute_path"), QStringLiteral("%1%2%3").arg(target.absolutePath(), PATH_SEPARATOR).arg(id));
+        if (targetId == TRASH_FOLDER_ID) {
+            query.bindValue(QStringLiteral(":is_pinned_note"), false);
+            query.bindValue(QStringLiteral(":deletion_date"), deletionTime);
+        }
+        query.bindValue(QStringLiteral(":id"), id);
+        query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
+        if (!query.exec()) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError() << query.lastQuery();
+            continue;
+        }
+        affectedFolders.insert(parentId);
+        int tagDelta = 0;
+        if (parentId != TRASH_FOLDER_ID && targetId == TRASH_FOLDER_ID) {
+            tagDelta = -1;
+        } else if (parentId == TRASH_FOLDER_ID && targetId != TRASH_FOLDER_ID) {
+            tagDelta = 1;
+        }
+        if (tagDelta != 0) {
+            const auto tagIds = getAllTagForNote(id);
+            for (const auto tagId : tagIds) {
+                tagCountChanges[tagId] += tagDelta;
+            }
+        }
+    }
+    if (!m_db.commit()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    for (const auto folderId : std::as_const(affectedFolders)) {
+        recalculateChildNotesCountFolder(folderId);
+    }
+    if (affectedFolders.contains(TRASH_FOLDER_ID)) {
+        recalculateChildNotesCountAllNotes();
+    }
+    for (auto it = tagCountChanges.constBegin(); it != tagCountChanges.constEnd(); ++it) {
+        if (it.value() != 0) {
+            changeChildNotesCountTag(it.key(), it.value());
+        }
+    }
+}
+
 void DBManager::removeTag(int tagId)
 {
     QSqlQuery query(m_db);
@@ -957,27 +1505,35 @@ bool DBManager::updateNoteContent(const NodeData &note)
         qDebug() << "Invalid Note ID";
         return false;
     }
-    qint64 epochTimeDateModified = note.lastModificationdateTime().toMSecsSinceEpoch();
+    qint64 epochTimeDateModified = note.lastModificationTime();
     QString content = note.content();
     content.replace(QChar('\x0'), emptyStr);
     QString fullTitle = note.fullTitle();
     fullTitle.replace(QChar('\x0'), emptyStr);
 
+    removeFromSearchIndex(id);
     if (!query.prepare(QStringLiteral("UPDATE node_table SET modification_date = :modification_date, content = :content, "
-                                      "title = :title, scrollbar_position = :scrollbar_position WHERE id = :id AND node_type "
-                                      "= :node_type;"))) {
+                                      "title = :title, display_title = :display_title, preview = :preview, "
+                                      "scrollbar_position = :scrollbar_position WHERE id = :id AND node_type = :node_type;"))) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
     query.bindValue(QStringLiteral(":modification_date"), epochTimeDateModified);
-    query.bindValue(QStringLiteral(":content"), content);
+    auto encodedContent = encodeNoteContent(content);
+    query.bindValue(QStringLiteral(":content"), encodedContent);
     query.bindValue(QStringLiteral(":title"), fullTitle);
+    query.bindValue(QStringLiteral(":display_title"), NodeData::getDisplayTitle(fullTitle));
+    query.bindValue(QStringLiteral(":preview"), NodeData::getSecondLine(content));
     query.bindValue(QStringLiteral(":id"), id);
     query.bindValue(QStringLiteral(":scrollbar_position"), note.scrollBarPosition());
     query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
     if (!query.exec()) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
-    return (query.numRowsAffected() == 1);
+    bool isUpdated = query.numRowsAffected() == 1;
+    if (isUpdated) {
+        addToSearchIndex(id, encodedContent, content);
+    }
+    return isUpdated;
 }
 
 QList<NodeData> DBManager::readOldNBK(const QString &fileName)
@@ -1063,6 +1619,39 @@ NodePath DBManager::getNodeAbsolutePath(int nodeId)
     return absolutePath;
 }
 
+/*!
+ * \brief DBManager::getNotesContent
+ * Bodies of the given notes in one query, for the notes the editor is about
+ * to show while the list only holds their preview
+ * \param noteIds
+ * \return
+ */
+NoteContentMap DBManager::getNotesContent(const QSet<int> &noteIds)
+{
+    NoteContentMap contents;
+    if (noteIds.isEmpty()) {
+        return contents;
+    }
+    QStringList idList;
+    idList.reserve(noteIds.size());
+    for (const auto &id : noteIds) {
+        idList.append(QString::number(id));
+    }
+    QSqlQuery query(m_db);
+    if (!query.prepare(QStringLiteral(R"(SELECT "id", "content" FROM node_table WHERE id IN (%1);)").arg(idList.join(QLatin1Char(','))))) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        return contents;
+    }
+    contents.reserve(noteIds.size());
+    while (query.next()) {
+        contents.insert(query.value(0).toInt(), decodeNoteContent(query.value(1)));
+    }
+    return contents;
+}
+
 NodeData DBManager::getNode(int nodeId)
 {
     QSqlQuery query(m_db);
@@ -1080,7 +1669,9 @@ NodeData DBManager::getNode(int nodeId)
                        R"("absolute_path", )"
                        R"("is_pinned_note", )"
                        R"("relative_position_an", )"
-                       R"("child_notes_count" )"
+                       R"("child_notes_count", )"
+                       R"("display_title", )"
+                       R"("preview" )"
                        R"(FROM node_table WHERE id=:id LIMIT 1;)")) {
         qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
     }
@@ -1091,18 +1682,20 @@ NodeData DBManager::getNode(int nodeId)
         NodeData node;
         node.setId(query.value(0).toInt());
         node.setFullTitle(query.value(1).toString());
-        node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(2).toLongLong()));
-        node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(3).toLongLong()));
-        node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(query.value(4).toLongLong()));
-        node.setContent(query.value(5).toString());
+        node.setCreationTime(query.value(2).toLongLong());
+        node.setLastModificationTime(query.value(3).toLongLong());
+        node.setDeletionTime(query.value(4).toLongLong());
+        node.setContent(decodeNoteContent(query.value(5)));
         node.setNodeType(static_cast<NodeData::Type>(query.value(6).toInt()));
         node.setParentId(query.value(7).toInt());
         node.setRelativePosition(query.value(8).toInt());
         node.setScrollBarPosition(query.value(9).toInt());
         node.setAbsolutePath(query.value(10).toString());
         node.setIsPinnedNote(static_cast<bool>(query.value(11).toInt()));
-        node.setRelativePosAN(query.value(13).toInt());
-        node.setRelativePosAN(query.value(14).toInt());
+        node.setRelativePosAN(query.value(12).toInt());
+        node.setChildNotesCount(query.value(13).toInt());
+        node.setDisplayTitle(query.value(14).toString());
+        node.setPreview(query.value(15).toString());
         if (node.nodeType() == NodeData::Type::Note) {
             node.setTagIds(getAllTagForNote(node.id()));
             QSqlQuery query2(m_db);
@@ -1302,7 +1895,7 @@ void DBManager::searchForNotes(const QString &keyword, const ListViewInfo &inf)
                            R"("creation_date",)"
                            R"("modification_date",)"
                            R"("deletion_date",)"
-                           R"("content",)"
+                           R"("preview",)"
                            R"("node_type",)"
                            R"("parent_id",)"
                            R"("relative_position", )"
@@ -1310,10 +1903,11 @@ void DBManager::searchForNotes(const QString &keyword, const ListViewInfo &inf)
                            R"("absolute_path", )"
                            R"("is_pinned_note", )"
                            R"("relative_position_an", )"
-                           R"("child_notes_count" )"
+                           R"("child_notes_count", )"
+                           R"("display_title" )"
                            R"(FROM node_table )"
                            R"(WHERE node_type = (:node_type) AND parent_id != (:parent_id) )"
-                           R"(AND content like  '%' || (:search_expr) || '%';)")) {
+                           R"(AND )" + contentSearchCondition(keyword) + QStringLiteral(";"))) {
             qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
         }
         query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
@@ -1326,18 +1920,20 @@ void DBManager::searchForNotes(const QString &keyword, const ListViewInfo &inf)
                 NodeData node;
                 node.setId(query.value(0).toInt());
                 node.setFullTitle(query.value(1).toString());
-                node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(2).toLongLong()));
-                node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(3).toLongLong()));
-                node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(query.value(4).toLongLong()));
-                node.setContent(query.value(5).toString());
+                node.setCreationTime(query.value(2).toLongLong());
+                node.setLastModificationTime(query.value(3).toLongLong());
+                node.setDeletionTime(query.value(4).toLongLong());
+                node.setPreview(query.value(5).toString());
+                node.setIsContentLoaded(false);
                 node.setNodeType(static_cast<NodeData::Type>(query.value(6).toInt()));
                 node.setParentId(query.value(7).toInt());
                 node.setRelativePosition(query.value(8).toInt());
                 node.setScrollBarPosition(query.value(9).toInt());
                 node.setAbsolutePath(query.value(10).toString());
                 node.setIsPinnedNote(static_cast<bool>(query.value(11).toInt()));
-                node.setRelativePosAN(query.value(13).toInt());
-                node.setChildNotesCount(query.value(14).toInt());
+                node.setRelativePosAN(query.value(12).toInt());
+                node.setChildNotesCount(query.value(13).toInt());
+                node.setDisplayTitle(query.value(14).toString());
                 node.setTagIds(getAllTagForNote(node.id()));
                 auto p = getNode(node.parentId());
                 node.setParentName(p.fullTitle());
@@ -1353,7 +1949,7 @@ void DBManager::searchForNotes(const QString &keyword, const ListViewInfo &inf)
                            R"("creation_date",)"
                            R"("modification_date",)"
                            R"("deletion_date",)"
-                           R"("content",)"
+                           R"("preview",)"
                            R"("node_type",)"
                            R"("parent_id",)"
                            R"("relative_position", )"
@@ -1361,10 +1957,11 @@ void DBManager::searchForNotes(const QString &keyword, const ListViewInfo &inf)
                            R"("absolute_path", )"
                            R"("is_pinned_note", )"
                            R"("relative_position_an", )"
-                           R"("child_notes_count" )"
+                           R"("child_notes_count", )"
+                           R"("display_title" )"
                            R"(FROM node_table )"
                            R"(WHERE node_type = (:node_type) AND parent_id == (:parent_id) )"
-                           R"(AND content like  '%' || (:search_expr) || '%';)")) {
+                           R"(AND )" + contentSearchCondition(keyword) + QStringLiteral(";"))) {
             qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
         }
         query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
@@ -1377,18 +1974,20 @@ void DBManager::searchForNotes(const QString &keyword, const ListViewInfo &inf)
                 NodeData node;
                 node.setId(query.value(0).toInt());
                 node.setFullTitle(query.value(1).toString());
-                node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(2).toLongLong()));
-                node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(3).toLongLong()));
-                node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(query.value(4).toLongLong()));
-                node.setContent(query.value(5).toString());
+                node.setCreationTime(query.value(2).toLongLong());
+                node.setLastModificationTime(query.value(3).toLongLong());
+                node.setDeletionTime(query.value(4).toLongLong());
+                node.setPreview(query.value(5).toString());
+                node.setIsContentLoaded(false);
                 node.setNodeType(static_cast<NodeData::Type>(query.value(6).toInt()));
                 node.setParentId(query.value(7).toInt());
                 node.setRelativePosition(query.value(8).toInt());
                 node.setScrollBarPosition(query.value(9).toInt());
                 node.setAbsolutePath(query.value(10).toString());
                 node.setIsPinnedNote(static_cast<bool>(query.value(11).toInt()));
-                node.setRelativePosAN(query.value(13).toInt());
-                node.setChildNotesCount(query.value(14).toInt());
+                node.setRelativePosAN(query.value(12).toInt());
+                node.setChildNotesCount(query.value(13).toInt());
+                node.setDisplayTitle(query.value(14).toString());
                 node.setTagIds(getAllTagForNote(node.id()));
                 auto p = getNode(node.parentId());
                 node.setParentName(p.fullTitle());
@@ -1440,19 +2039,12 @@ void DBManager::searchForNotes(const QString &keyword, const ListViewInfo &inf)
                 noteIds.insert(id);
             }
         }
-        for (const auto &id : noteIds) {
-            NodeData node = getNode(id);
-            if (node.id() != INVALID_NODE_ID && node.nodeType() == NodeData::Type::Note && node.content().contains(keyword)) {
-                nodeList.append(node);
-            } else {
-                qDebug() << __FUNCTION__ << "Note with id" << id << "is not valid";
-            }
-        }
+        nodeList = getNoteListByIds(noteIds, keyword);
     }
     ListViewInfo inf2 = inf;
     inf2.isInSearch = true;
     std::sort(nodeList.begin(), nodeList.end(),
-              [](const NodeData &a, const NodeData &b) -> bool { return a.lastModificationdateTime() > b.lastModificationdateTime(); });
+              [](const NodeData &a, const NodeData &b) -> bool { return a.lastModificationTime() > b.lastModificationTime(); });
     emit notesListReceived(nodeList, inf2);
 }
 
@@ -1547,6 +2139,32 @@ void DBManager::setNoteIsPinned(int noteId, bool isPinned)
     }
 }
 
+void DBManager::setNotesIsPinned(const QSet<int> &noteIds, bool isPinned)
+{
+    if (noteIds.isEmpty()) {
+        return;
+    }
+    if (!m_db.transaction()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+    QSqlQuery query(m_db);
+    if (!query.prepare(QStringLiteral("UPDATE node_table SET is_pinned_note = :is_pinned_note "
+                                      "WHERE id = :id AND node_type=:node_type;"))) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    for (const auto noteId : noteIds) {
+        query.bindValue(QStringLiteral(":is_pinned_note"), isPinned);
+        query.bindValue(QStringLiteral(":id"), noteId);
+        query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
+        if (!query.exec()) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+    }
+    if (!m_db.commit()) {
+        qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+    }
+}
+
 NodeData DBManager::getChildNotesCountFolder(int folderId)
 {
     NodeData d;
@@ -1580,6 +2198,121 @@ void DBManager::onNodeTagTreeRequested()
     emit nodesTagTreeReceived(d);
 }
 
+/*!
+ * \brief DBManager::onSaveStartupSnapshotRequested
+ * Writes the folder tree, tags, badge counts and the given list page to
+ * fileName so the next launch can paint them before the database is open.
+ * Search results and temporary notes are never persisted.
+ */
+void DBManager::onSaveStartupSnapshotRequested(const QString &fileName, const QVector<NodeData> &noteList, const ListViewInfo &inf,
+                                               const QString &listLabel1, const QString &listLabel2)
+{
+    StartupSnapshot snapshot;
+    snapshot.dbPath = QFileInfo(m_dbpath).absoluteFilePath();
+    snapshot.treeData.nodeTreeData = getAllFolders();
+    snapshot.treeData.tagTreeData = getAllTagInfo();
+    snapshot.allNotesCount = getChildNotesCountFolder(ROOT_FOLDER_ID).childNotesCount();
+    snapshot.trashCount = getChildNotesCountFolder(TRASH_FOLDER_ID).childNotesCount();
+    if (!inf.isInSearch) {
+        snapshot.isInTag = inf.isInTag;
+        snapshot.currentTagList = inf.currentTagList;
+        snapshot.parentFolderId = inf.parentFolderId;
+        snapshot.listLabel1 = listLabel1;
+        snapshot.listLabel2 = listLabel2;
+        snapshot.notes.reserve(noteList.size());
+        for (const auto &note : noteList) {
+            if (!note.isTempNote()) {
+                snapshot.notes.append(note);
+            }
+        }
+    }
+    snapshot.write(fileName);
+}
+
+/*!
+ * \brief DBManager::getNoteListByIds
+ * Loads notes the way the list shows them, with their preview line and
+ * without the body, like the folder lists do
+ * \param noteIds
+ * \param keyword when not null only the notes whose body contains it are returned
+ * \return
+ */
+QVector<NodeData> DBManager::getNoteListByIds(const QSet<int> &noteIds, const QString &keyword)
+{
+    QVector<NodeData> nodeList;
+    if (noteIds.isEmpty()) {
+        return nodeList;
+    }
+    QStringList idList;
+    idList.reserve(noteIds.size());
+    for (const auto &id : noteIds) {
+        idList.append(QString::number(id));
+    }
+    QString queryStr = QStringLiteral(R"(SELECT )"
+                                      R"("id",)"
+                                      R"("title",)"
+                                      R"("creation_date",)"
+                                      R"("modification_date",)"
+                                      R"("deletion_date",)"
+                                      R"("preview",)"
+                                      R"("node_type",)"
+                                      R"("parent_id",)"
+                                      R"("relative_position", )"
+                                      R"("scrollbar_position",)"
+                                      R"("absolute_path", )"
+                                      R"("is_pinned_note", )"
+                                      R"("relative_position_an", )"
+                                      R"("child_notes_count", )"
+                                      R"("display_title" )"
+                                      R"(FROM node_table )"
+                                      R"(WHERE id IN (%1) AND node_type = (:node_type))")
+                               .arg(idList.join(QLatin1Char(',')));
+    if (!keyword.isNull()) {
+        // same content match as the folder searches so every search follows one case rule
+        queryStr += QStringLiteral(" AND ") + contentSearchCondition(keyword);
+    }
+    QSqlQuery query(m_db);
+    if (!query.prepare(queryStr)) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
+    if (!keyword.isNull()) {
+        query.bindValue(QStringLiteral(":search_expr"), keyword);
+    }
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        return nodeList;
+    }
+    QHash<int, QString> parentNames;
+    while (query.next()) {
+        NodeData node;
+        node.setId(query.value(0).toInt());
+        node.setFullTitle(query.value(1).toString());
+        node.setCreationTime(query.value(2).toLongLong());
+        node.setLastModificationTime(query.value(3).toLongLong());
+        node.setDeletionTime(query.value(4).toLongLong());
+        node.setPreview(query.value(5).toString());
+        node.setIsContentLoaded(false);
+        node.setNodeType(static_cast<NodeData::Type>(query.value(6).toInt()));
+        node.setParentId(query.value(7).toInt());
+        node.setRelativePosition(query.value(8).toInt());
+        node.setScrollBarPosition(query.value(9).toInt());
+        node.setAbsolutePath(query.value(10).toString());
+        node.setIsPinnedNote(static_cast<bool>(query.value(11).toInt()));
+        node.setRelativePosAN(query.value(12).toInt());
+        node.setChildNotesCount(query.value(13).toInt());
+        node.setDisplayTitle(query.value(14).toString());
+        node.setTagIds(getAllTagForNote(node.id()));
+        auto parentName = parentNames.constFind(node.parentId());
+        if (parentName == parentNames.constEnd()) {
+            parentName = parentNames.insert(node.parentId(), getNode(node.parentId()).fullTitle());
+        }
+        node.setParentName(parentName.value());
+        nodeList.append(node);
+    }
+    return nodeList;
+}
+
 /*!
  * \brief DBManager::onNotesListRequested
  */
@@ -1594,7 +2327,7 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                            R"("creation_date",)"
                            R"("modification_date",)"
                            R"("deletion_date",)"
-                           R"("content",)"
+                           R"("preview",)"
                            R"("node_type",)"
                            R"("parent_id",)"
                            R"("relative_position",)"
@@ -1602,7 +2335,8 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                            R"("absolute_path", )"
                            R"("is_pinned_note", )"
                            R"("relative_position_an", )"
-                           R"("child_notes_count" )"
+                           R"("child_notes_count", )"
+                           R"("display_title" )"
                            R"(FROM node_table )"
                            R"(WHERE node_type = (:node_type) AND parent_id != (:parent_id);)")) {
             qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
@@ -1616,18 +2350,20 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                 NodeData node;
                 node.setId(query.value(0).toInt());
                 node.setFullTitle(query.value(1).toString());
-                node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(2).toLongLong()));
-                node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(3).toLongLong()));
-                node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(query.value(4).toLongLong()));
-                node.setContent(query.value(5).toString());
+                node.setCreationTime(query.value(2).toLongLong());
+                node.setLastModificationTime(query.value(3).toLongLong());
+                node.setDeletionTime(query.value(4).toLongLong());
+                node.setPreview(query.value(5).toString());
+                node.setIsContentLoaded(false);
                 node.setNodeType(static_cast<NodeData::Type>(query.value(6).toInt()));
                 node.setParentId(query.value(7).toInt());
                 node.setRelativePosition(query.value(8).toInt());
                 node.setScrollBarPosition(query.value(9).toInt());
                 node.setAbsolutePath(query.value(10).toString());
                 node.setIsPinnedNote(static_cast<bool>(query.value(11).toInt()));
-                node.setRelativePosAN(query.value(13).toInt());
-                node.setChildNotesCount(query.value(14).toInt());
+                node.setRelativePosAN(query.value(12).toInt());
+                node.setChildNotesCount(query.value(13).toInt());
+                node.setDisplayTitle(query.value(14).toString());
                 node.setTagIds(getAllTagForNote(node.id()));
                 auto p = getNode(node.parentId());
                 node.setParentName(p.fullTitle());
@@ -1643,7 +2379,7 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                            R"("creation_date",)"
                            R"("modification_date",)"
                            R"("deletion_date",)"
-                           R"("content",)"
+                           R"("preview",)"
                            R"("node_type",)"
                            R"("parent_id",)"
                            R"("relative_position", )"
@@ -1651,7 +2387,8 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                            R"("absolute_path", )"
                            R"("is_pinned_note", )"
                            R"("relative_position_an", )"
-                           R"("child_notes_count" )"
+                           R"("child_notes_count", )"
+                           R"("display_title" )"
                            R"(FROM node_table )"
                            R"(WHERE parent_id = (:parent_id) AND node_type = (:node_type);)")) {
             qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
@@ -1664,18 +2401,20 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                 NodeData node;
                 node.setId(query.value(0).toInt());
                 node.setFullTitle(query.value(1).toString());
-                node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(2).toLongLong()));
-                node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(3).toLongLong()));
-                node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(query.value(4).toLongLong()));
-                node.setContent(query.value(5).toString());
+                node.setCreationTime(query.value(2).toLongLong());
+                node.setLastModificationTime(query.value(3).toLongLong());
+                node.setDeletionTime(query.value(4).toLongLong());
+                node.setPreview(query.value(5).toString());
+                node.setIsContentLoaded(false);
                 node.setNodeType(static_cast<NodeData::Type>(query.value(6).toInt()));
                 node.setParentId(query.value(7).toInt());
                 node.setRelativePosition(query.value(8).toInt());
                 node.setScrollBarPosition(query.value(9).toInt());
                 node.setAbsolutePath(query.value(10).toString());
                 node.setIsPinnedNote(static_cast<bool>(query.value(11).toInt()));
-                node.setRelativePosAN(query.value(13).toInt());
-                node.setChildNotesCount(query.value(14).toInt());
+                node.setRelativePosAN(query.value(12).toInt());
+                node.setChildNotesCount(query.value(13).toInt());
+                node.setDisplayTitle(query.value(14).toString());
                 node.setTagIds(getAllTagForNote(node.id()));
                 nodeList.append(node);
             }
@@ -1690,7 +2429,7 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                            R"("creation_date",)"
                            R"("modification_date",)"
                            R"("deletion_date",)"
-                           R"("content",)"
+                           R"("preview",)"
                            R"("node_type",)"
                            R"("parent_id",)"
                            R"("relative_position", )"
@@ -1698,7 +2437,8 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                            R"("absolute_path", )"
                            R"("is_pinned_note", )"
                            R"("relative_position_an", )"
-                           R"("child_notes_count" )"
+                           R"("child_notes_count", )"
+                           R"("display_title" )"
                            R"(FROM node_table )"
                            R"(WHERE absolute_path like (:path_expr) || '%' AND node_type = (:node_type);)")) {
             qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
@@ -1712,18 +2452,20 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
                 NodeData node;
                 node.setId(query.value(0).toInt());
                 node.setFullTitle(query.value(1).toString());
-                node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(2).toLongLong()));
-                node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(query.value(3).toLongLong()));
-                node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(query.value(4).toLongLong()));
-                node.setContent(query.value(5).toString());
+                node.setCreationTime(query.value(2).toLongLong());
+                node.setLastModificationTime(query.value(3).toLongLong());
+                node.setDeletionTime(query.value(4).toLongLong());
+                node.setPreview(query.value(5).toString());
+                node.setIsContentLoaded(false);
                 node.setNodeType(static_cast<NodeData::Type>(query.value(6).toInt()));
                 node.setParentId(query.value(7).toInt());
                 node.setRelativePosition(query.value(8).toInt());
                 node.setScrollBarPosition(query.value(9).toInt());
                 node.setAbsolutePath(query.value(10).toString());
                 node.setIsPinnedNote(static_cast<bool>(query.value(11).toInt()));
-                node.setRelativePosAN(query.value(13).toInt());
-                node.setChildNotesCount(query.value(14).toInt());
+                node.setRelativePosAN(query.value(12).toInt());
+                node.setChildNotesCount(query.value(13).toInt());
+                node.setDisplayTitle(query.value(14).toString());
                 node.setTagIds(getAllTagForNote(node.id()));
                 nodeList.append(node);
             }
@@ -1739,7 +2481,7 @@ void DBManager::onNotesListInFolderRequested(int parentID, bool isRecursive, boo
     inf.needCreateNewNote = newNote;
     inf.scrollToId = scrollToId;
     std::sort(nodeList.begin(), nodeList.end(),
-              [](const NodeData &a, const NodeData &b) -> bool { return a.lastModificationdateTime() > b.lastModificationdateTime(); });
+              [](const NodeData &a, const NodeData &b) -> bool { return a.lastModificationTime() > b.lastModificationTime(); });
     emit notesListReceived(nodeList, inf);
 }
 
@@ -1796,16 +2538,9 @@ void DBManager::onNotesListInTagsRequested(const QSet<int> &tagIds, bool newNote
             noteIds.insert(id);
         }
     }
-    for (const auto &id : noteIds) {
-        NodeData node = getNode(id);
-        if (node.id() != INVALID_NODE_ID && node.nodeType() == NodeData::Type::Note) {
-            nodeList.append(node);
-        } else {
-            qDebug() << __FUNCTION__ << "Note with id" << id << "is not valid";
-        }
-    }
+    nodeList = getNoteListByIds(noteIds);
     std::sort(nodeList.begin(), nodeList.end(),
-              [](const NodeData &a, const NodeData &b) -> bool { return a.lastModificationdateTime() > b.lastModificationdateTime(); });
+              [](const NodeData &a, const NodeData &b) -> bool { return a.lastModificationTime() > b.lastModificationTime(); });
     emit notesListReceived(nodeList, inf);
 }
 
@@ -1817,10 +2552,74 @@ void DBManager::onNotesListInTagsRequested(const QSet<int> &tagIds, bool newNote
 void DBManager::onOpenDBManagerRequested(const QString &path, bool doCreate)
 {
     open(path, doCreate);
+    emit databaseOpened();
+}
+
+/*!
+ * \brief DBManager::reencodeNoteContent
+ * Compress large notes that were saved as plain text, a small batch at a time
+ * so requests coming from the UI are not blocked behind the whole pass
+ * \param fromId only notes with a greater id are visited
+ */
+void DBManager::reencodeNoteContent(int fromId)
+{
+    QSqlQuery query(m_db);
+    if (!query.prepare(R"(SELECT "id", "content" FROM node_table )"
+                       R"(WHERE node_type = :node_type AND id > :from_id AND typeof(content) = 'text' )"
+                       R"(AND length(CAST(content AS BLOB)) >= :threshold ORDER BY id LIMIT :batch;)")) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+    }
+    query.bindValue(QStringLiteral(":node_type"), static_cast<int>(NodeData::Type::Note));
+    query.bindValue(QStringLiteral(":from_id"), fromId);
+    query.bindValue(QStringLiteral(":threshold"), COMPRESSED_CONTENT_THRESHOLD);
+    query.bindValue(QStringLiteral(":batch"), COMPRESSED_CONTENT_REENCODE_BATCH);
+    if (!query.exec()) {
+        qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        return;
+    }
+    QVector<QPair<int, QVariant>> encoded;
+    QVector<QString> plainTexts;
+    int visited = 0;
+    while (query.next()) {
+        ++visited;
+        fromId = query.value(0).toInt();
+        QString plainText = query.value(1).toString();
+        auto content = encodeNoteContent(plainText);
+        if (content.typeId() == QMetaType::QByteArray) {
+            encoded.append(qMakePair(fromId, content));
+            plainTexts.append(plainText);
+        }
+    }
+    query.finish();
+    if (!encoded.isEmpty()) {
+        if (!m_db.transaction()) {
+            qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+        }
+        if (!query.prepare(R"(UPDATE node_table SET content = :content WHERE id = :id;)")) {
+            qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+        }
+        for (int i = 0; i < encoded.size(); ++i) {
+            query.bindValue(QStringLiteral(":content"), encoded[i].second);
+            query.bindValue(QStringLiteral(":id"), encoded[i].first);
+            if (!query.exec()) {
+                qDebug() << __FUNCTION__ << __LINE__ << query.lastError();
+                continue;
+            }
+            addToSearchIndex(encoded[i].first, encoded[i].second, plainTexts[i]);
+        }
+        if (!m_db.commit()) {
+            qDebug() << __FUNCTION__ << __LINE__ << m_db.lastError();
+        }
+    }
+    if (visited == COMPRESSED_CONTENT_REENCODE_BATCH) {
+        QMetaObject::invokeMethod(this, "reencodeNoteContent", Qt::QueuedConnection, Q_ARG(int, fromId));
+    }
 }
 
 /*!
- * \brief DBManager::onCreateUpdateRequested
+ * \brief DBManager::onCreateUpdateRequestedNoteContent
+ * NUL stripping, encoding and the preview line of the saved note are all
+ * computed here on the database thread
  * \param note
  */
 void DBManager::onCreateUpdateRequestedNoteContent(const NodeData &note)
@@ -1935,10 +2734,10 @@ void DBManager::onImportNotesRequested(const QString &fileName)
                     NodeData node;
                     node.setId(outQuery.value(0).toInt());
                     node.setFullTitle(outQuery.value(1).toString());
-                    node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(outQuery.value(2).toLongLong()));
-                    node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(outQuery.value(3).toLongLong()));
-                    node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(outQuery.value(4).toLongLong()));
-                    node.setContent(outQuery.value(5).toString());
+                    node.setCreationTime(outQuery.value(2).toLongLong());
+                    node.setLastModificationTime(outQuery.value(3).toLongLong());
+                    node.setDeletionTime(outQuery.value(4).toLongLong());
+                    node.setContent(decodeNoteContent(outQuery.value(5)));
                     node.setNodeType(static_cast<NodeData::Type>(outQuery.value(6).toInt()));
                     node.setParentId(outQuery.value(7).toInt());
                     node.setRelativePosition(outQuery.value(8).toInt());
@@ -2070,10 +2869,10 @@ void DBManager::onImportNotesRequested(const QString &fileName)
                     NodeData node;
                     node.setId(outQuery.value(0).toInt());
                     node.setFullTitle(outQuery.value(1).toString());
-                    node.setCreationDateTime(QDateTime::fromMSecsSinceEpoch(outQuery.value(2).toLongLong()));
-                    node.setLastModificationDateTime(QDateTime::fromMSecsSinceEpoch(outQuery.value(3).toLongLong()));
-                    node.setDeletionDateTime(QDateTime::fromMSecsSinceEpoch(outQuery.value(4).toLongLong()));
-                    node.setContent(outQuery.value(5).toString());
+                    node.setCreationTime(outQuery.value(2).toLongLong());
+                    node.setLastModificationTime(outQuery.value(3).toLongLong());
+                    node.setDeletionTime(outQuery.value(4).toLongLong());
+                    node.setContent(decodeNoteContent(outQuery.value(5)));
                     node.setNodeType(static_cast<NodeData::Type>(outQuery.value(6).toInt()));
                     node.setParentId(outQuery.value(7).toInt());
                     node.setRelativePosition(outQuery.value(8).toInt());
@@ -2612,7 +3411,7 @@ void DBManager::exportNotes(const QString &baseExportPath, const QString &extens
     while (query.next()) {
         // int noteId = query.value(0).toInt();
         QString title = query.value(1).toString();
-        QString content = query.value(2).toString();
+        QString content = decodeNoteContent(query.value(2));
         int parentId = query.value(3).toInt();
 
         QString notePath = folderPaths[parentId];
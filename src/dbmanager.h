@@ -6,6 +6,7 @@
 #include "nodepath.h"
 #include <QObject>
 #include <QtSql/QSqlDatabase>
+#include <QHash>
 #include <QPair>
 #include <QSet>
 #include <QVector>
@@ -36,6 +37,7 @@ struct Folder
 };
 
 using FolderListType = QMap<int, QString>;
+using NoteContentMap = QHash<int, QString>;
 
 class DBManager : public QObject
 {
@@ -44,6 +46,7 @@ public:
     explicit DBManager(QObject *parent = nullptr);
     Q_INVOKABLE NodePath getNodeAbsolutePath(int nodeId);
     Q_INVOKABLE NodeData getNode(int nodeId);
+    Q_INVOKABLE NoteContentMap getNotesContent(const QSet<int> &noteIds);
     Q_INVOKABLE void moveFolderToTrash(const NodeData &node);
     Q_INVOKABLE FolderListType getFolderList();
     void exportNotes(const QString &baseExportPath, const QString &extension);
@@ -52,14 +55,24 @@ public:
 private:
     void open(const QString &path, bool doCreate = false);
     void createTables();
+    void migrateDisplayColumns();
+    void createSearchIndex();
+    void addToSearchIndex(int noteId, const QVariant &encodedContent, const QString &content);
+    void removeFromSearchIndex(int noteId);
+    QString contentSearchCondition(const QString &keyword);
 
     bool isNodeExist(const NodeData &node);
     QString m_dbpath;
     QSqlDatabase m_db;
+    bool m_hasSearchIndex;
+    bool m_canDeleteFromSearchIndex;
 
     QVector<NodeData> getAllFolders();
     QVector<TagData> getAllTagInfo();
     QSet<int> getAllTagForNote(int noteId);
+    QVector<NodeData> getNoteListByIds(const QSet<int> &noteIds, const QString &keyword = QString());
+    QHash<int, int> getNoteParentIds(const QSet<int> &noteIds);
+    void moveNotesFromParents(const QHash<int, int> &noteParentIds, int targetId);
     bool updateNoteContent(const NodeData &note);
     QList<NodeData> readOldNBK(const QString &fileName);
     int nextAvailablePosition(int parentId, NodeData::Type nodeType);
@@ -72,10 +85,12 @@ private:
     void decreaseChildNotesCountTag(int tagId);
     void increaseChildNotesCountFolder(int folderId);
     void decreaseChildNotesCountFolder(int folderId);
+    void changeChildNotesCountTag(int tagId, int delta);
 
 signals:
     void notesListReceived(const QVector<NodeData> &noteList, const ListViewInfo &inf);
     void nodesTagTreeReceived(const NodeTagTreeData &treeData);
+    void databaseOpened();
 
     void tagAdded(const TagData &tag);
     void tagRemoved(int tagId);
@@ -83,7 +98,7 @@ signals:
     void tagColorChanged(int tagId, const QString &tagColor);
     void showErrorMessage(const QString &title, const QString &content);
     void childNotesCountUpdatedTag(int tagId, int childCount);
-    void childNotesCountUpdatedFolder(int folderId, const QString &path, int childCount);
+    void childNotesCountUpdatedFolder(int folderId, int childCount);
 
 public slots:
     void onNodeTagTreeRequested();
@@ -98,18 +113,25 @@ public slots:
     void onMigrateTrashFrom0_9_0Requested(QVector<NodeData> &noteList);
     void onMigrateNotesFrom1_5_0Requested(const QString &fileName);
     void onChangeDatabasePathRequested(const QString &newPath);
+    void reencodeNoteContent(int fromId);
+    void onSaveStartupSnapshotRequested(const QString &fileName, const QVector<NodeData> &noteList, const ListViewInfo &inf,
+                                        const QString &listLabel1, const QString &listLabel2);
 
     int addNode(const NodeData &node);
 
     int addTag(const TagData &tag);
     void addNoteToTag(int noteId, int tagId);
     void removeNoteFromTag(int noteId, int tagId);
+    void addNotesToTag(const QSet<int> &noteIds, int tagId);
+    void removeNotesFromTag(const QSet<int> &noteIds, int tagId);
     int nextAvailableNodeId();
     int nextAvailableTagId();
     void renameNode(int id, const QString &newName);
     void renameTag(int id, const QString &newName);
     void changeTagColor(int id, const QString &newColor);
     void removeNote(const NodeData &note);
+    void removeNotes(const QSet<int> &noteIds);
+    void moveNotes(const QSet<int> &noteIds, int targetId);
     void removeTag(int tagId);
     void moveNode(int nodeId, const NodeData &target);
     void searchForNotes(const QString &keyword, const ListViewInfo &inf);
@@ -119,6 +141,7 @@ public slots:
     void updateRelPosPinnedNote(int nodeId, int relPos);
     void updateRelPosPinnedNoteAN(int nodeId, int relPos);
     void setNoteIsPinned(int noteId, bool isPinned);
+    void setNotesIsPinned(const QSet<int> &noteIds, bool isPinned);
     NodeData getChildNotesCountFolder(int folderId);
 };
 
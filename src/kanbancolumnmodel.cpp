@@ -0,0 +1,239 @@
+#include "kanbancolumnmodel.h"
+#include <QDebug>
+#include <algorithm>
+
+KanbanColumnModel::KanbanColumnModel(QObject *parent) : QAbstractListModel(parent), m_tasksReversed(false) { }
+
+/*!
+ * \brief KanbanColumnModel::setColumns
+ * Returns true if columns or tasks were inserted or removed
+ */
+bool KanbanColumnModel::setColumns(const QVector<KanbanColumn> &columns)
+{
+    bool isLayoutChanged = false;
+    int common = std::min(m_items.size(), columns.size());
+    for (int i = 0; i < common; ++i) {
+        ColumnItem &item = m_items[i];
+        const KanbanColumn &column = columns[i];
+        QVector<int> changedRoles;
+        if (item.title != column.title) {
+            item.title = column.title;
+            changedRoles.append(static_cast<int>(ColumnRole::TitleRole));
+        }
+        if (item.startLine != column.startLine) {
+            item.startLine = column.startLine;
+            changedRoles.append(static_cast<int>(ColumnRole::StartLineRole));
+        }
+        if (item.endLine != column.endLine) {
+            item.endLine = column.endLine;
+            changedRoles.append(static_cast<int>(ColumnRole::EndLineRole));
+        }
+        if (!changedRoles.isEmpty()) {
+            emit dataChanged(index(i), index(i), changedRoles);
+        }
+        isLayoutChanged = item.taskModel->setTasks(orderedTasks(column)) || isLayoutChanged;
+    }
+    if (columns.size() > m_items.size()) {
+        beginInsertRows(QModelIndex(), m_items.size(), columns.size() - 1);
+        for (int i = m_items.size(); i < columns.size(); ++i) {
+            const KanbanColumn &column = columns[i];
+            ColumnItem item = createItem(column.title, getNewColumnID(), column.startLine, column.endLine);
+            item.taskModel->setTasks(orderedTasks(column));
+            m_items.append(item);
+        }
+        endInsertRows();
+        emit countChanged();
+        isLayoutChanged = true;
+    } else if (columns.size() < m_items.size()) {
+        remove(columns.size(), m_items.size() - columns.size());
+        isLayoutChanged = true;
+    }
+    return isLayoutChanged;
+}
+
+bool KanbanColumnModel::tasksReversed() const
+{
+    return m_tasksReversed;
+}
+
+void KanbanColumnModel::setTasksReversed(bool tasksReversed)
+{
+    if (m_tasksReversed == tasksReversed) {
+        return;
+    }
+    m_tasksReversed = tasksReversed;
+    // each column flips the tasks it currently holds, so columns the board
+    // already moved, removed or added stay with their own tasks
+    for (const auto &item : std::as_const(m_items)) {
+        item.taskModel->reverseTasks();
+    }
+    emit tasksReversedChanged();
+}
+
+int KanbanColumnModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return m_items.size();
+}
+
+QVariant KanbanColumnModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_items.size()) {
+        return {};
+    }
+    const ColumnItem &item = m_items[index.row()];
+    switch (static_cast<ColumnRole>(role)) {
+    case ColumnRole::TitleRole:
+        return item.title;
+    case ColumnRole::ColumnIdRole:
+        return item.columnId;
+    case ColumnRole::StartLineRole:
+        return item.startLine;
+    case ColumnRole::EndLineRole:
+        return item.endLine;
+    }
+    return {};
+}
+
+QHash<int, QByteArray> KanbanColumnModel::roleNames() const
+{
+    return {
+        { static_cast<int>(ColumnRole::TitleRole), "title" },
+        { static_cast<int>(ColumnRole::ColumnIdRole), "columnID" },
+        { static_cast<int>(ColumnRole::StartLineRole), "columnStartLine" },
+        { static_cast<int>(ColumnRole::EndLineRole), "columnEndLine" },
+    };
+}
+
+QObject *KanbanColumnModel::taskModelByColumnID(int columnId) const
+{
+    for (const auto &item : std::as_const(m_items)) {
+        if (item.columnId == columnId) {
+            return item.taskModel;
+        }
+    }
+    return nullptr;
+}
+
+int KanbanColumnModel::getNewColumnID() const
+{
+    int previousLargest = -1;
+    for (const auto &item : std::as_const(m_items)) {
+        previousLargest = std::max(previousLargest, item.columnId);
+    }
+    return previousLargest + 1;
+}
+
+int KanbanColumnModel::taskCount() const
+{
+    int count = 0;
+    for (const auto &item : std::as_const(m_items)) {
+        count += item.taskModel->rowCount();
+    }
+    return count;
+}
+
+int KanbanColumnModel::completedTaskCount() const
+{
+    int count = 0;
+    for (const auto &item : std::as_const(m_items)) {
+        count += item.taskModel->completedCount();
+    }
+    return count;
+}
+
+QVariantMap KanbanColumnModel::get(int row) const
+{
+    if (row < 0 || row >= m_items.size()) {
+        return {};
+    }
+    const ColumnItem &item = m_items[row];
+    return {
+        { QStringLiteral("title"), item.title },
+        { QStringLiteral("columnID"), item.columnId },
+        { QStringLiteral("columnStartLine"), item.startLine },
+        { QStringLiteral("columnEndLine"), item.endLine },
+    };
+}
+
+void KanbanColumnModel::append(const QVariantMap &column)
+{
+    int row = m_items.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_items.append(createItem(column.value(QStringLiteral("title")).toString(),
+                              column.value(QStringLiteral("columnID"), getNewColumnID()).toInt(),
+                              column.value(QStringLiteral("columnStartLine")).toInt(), column.value(QStringLiteral("columnEndLine")).toInt()));
+    endInsertRows();
+    emit countChanged();
+}
+
+void KanbanColumnModel::remove(int row, int count)
+{
+    if (row < 0 || count < 1 || row + count > m_items.size()) {
+        qDebug() << __FUNCTION__ << "Invalid range" << row << count;
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    for (int i = row; i < row + count; ++i) {
+        // delegates of the removed rows may still hold on to it
+        m_items[i].taskModel->deleteLater();
+    }
+    m_items.remove(row, count);
+    endRemoveRows();
+    emit countChanged();
+}
+
+void KanbanColumnModel::move(int from, int to, int count)
+{
+    if (count < 1 || from < 0 || to < 0 || from + count > m_items.size() || to + count > m_items.size() || from == to) {
+        return;
+    }
+    // same semantics as ListModel::move, Qt wants the row before which the
+    // moved block lands in the unmoved model
+    int destination = to > from ? to + count : to;
+    if (!beginMoveRows(QModelIndex(), from, from + count - 1, QModelIndex(), destination)) {
+        qDebug() << __FUNCTION__ << "Invalid move" << from << to << count;
+        return;
+    }
+    QVector<ColumnItem> moved = m_items.mid(from, count);
+    m_items.remove(from, count);
+    for (int i = 0; i < count; ++i) {
+        m_items.insert(to + i, moved[i]);
+    }
+    endMoveRows();
+}
+
+void KanbanColumnModel::clear()
+{
+    if (m_items.isEmpty()) {
+        return;
+    }
+    beginResetModel();
+    for (const auto &item : std::as_const(m_items)) {
+        item.taskModel->deleteLater();
+    }
+    m_items.clear();
+    endResetModel();
+    emit countChanged();
+}
+
+QVector<KanbanTask> KanbanColumnModel::orderedTasks(const KanbanColumn &column) const
+{
+    if (!m_tasksReversed) {
+        return column.tasks;
+    }
+    QVector<KanbanTask> tasks = column.tasks;
+    std::reverse(tasks.begin(), tasks.end());
+    return tasks;
+}
+
+KanbanColumnModel::ColumnItem KanbanColumnModel::createItem(const QString &title, int columnId, int startLine, int endLine)
+{
+    ColumnItem item;
+    item.title = title;
+    item.columnId = columnId;
+    item.startLine = startLine;
+    item.endLine = endLine;
+    item.taskModel = new KanbanTaskModel(this);
+    return item;
+}
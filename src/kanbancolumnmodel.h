@@ -0,0 +1,80 @@
+#ifndef KANBANCOLUMNMODEL_H
+#define KANBANCOLUMNMODEL_H
+
+#include <QAbstractListModel>
+#include <QVariantMap>
+#include <QVector>
+#include "kanbantaskmodel.h"
+
+struct KanbanColumn
+{
+    QString title;
+    int startLine{ 0 };
+    int endLine{ 0 };
+    QVector<KanbanTask> tasks;
+
+    bool operator==(const KanbanColumn &other) const
+    {
+        return title == other.title && startLine == other.startLine && endLine == other.endLine && tasks == other.tasks;
+    }
+};
+
+/*!
+ * \brief The KanbanColumnModel class
+ * Columns of the Kanban board, each row owning the KanbanTaskModel of its
+ * tasks. setColumns diffs against the current rows so the board only
+ * updates the delegates whose column or task actually changed
+ */
+class KanbanColumnModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+    Q_PROPERTY(bool tasksReversed READ tasksReversed WRITE setTasksReversed NOTIFY tasksReversedChanged)
+public:
+    enum class ColumnRole : std::uint16_t {
+        TitleRole = Qt::UserRole + 1,
+        ColumnIdRole,
+        StartLineRole,
+        EndLineRole,
+    };
+
+    explicit KanbanColumnModel(QObject *parent = nullptr);
+    bool setColumns(const QVector<KanbanColumn> &columns);
+    bool tasksReversed() const;
+    void setTasksReversed(bool tasksReversed);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE QObject *taskModelByColumnID(int columnId) const;
+    Q_INVOKABLE int getNewColumnID() const;
+    Q_INVOKABLE int taskCount() const;
+    Q_INVOKABLE int completedTaskCount() const;
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE void append(const QVariantMap &column);
+    Q_INVOKABLE void remove(int row, int count = 1);
+    Q_INVOKABLE void move(int from, int to, int count = 1);
+    Q_INVOKABLE void clear();
+
+signals:
+    void countChanged();
+    void tasksReversedChanged();
+
+private:
+    struct ColumnItem
+    {
+        QString title;
+        int columnId{ 0 };
+        int startLine{ 0 };
+        int endLine{ 0 };
+        KanbanTaskModel *taskModel{ nullptr };
+    };
+    QVector<ColumnItem> m_items;
+    bool m_tasksReversed;
+
+    QVector<KanbanTask> orderedTasks(const KanbanColumn &column) const;
+    ColumnItem createItem(const QString &title, int columnId, int startLine, int endLine);
+};
+
+#endif // KANBANCOLUMNMODEL_H
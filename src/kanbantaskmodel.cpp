@@ -0,0 +1,194 @@
+#include "kanbantaskmodel.h"
+#include <QDebug>
+#include <algorithm>
+
+KanbanTaskModel::KanbanTaskModel(QObject *parent) : QAbstractListModel(parent) { }
+
+/*!
+ * \brief KanbanTaskModel::setTasks
+ * Returns true if rows were inserted or removed
+ */
+bool KanbanTaskModel::setTasks(const QVector<KanbanTask> &tasks)
+{
+    int common = std::min(m_items.size(), tasks.size());
+    for (int i = 0; i < common; ++i) {
+        TaskItem &item = m_items[i];
+        const KanbanTask &task = tasks[i];
+        QVector<int> changedRoles;
+        if (item.task.text != task.text) {
+            changedRoles.append(static_cast<int>(TaskRole::TextRole));
+        }
+        if (item.task.checked != task.checked) {
+            changedRoles.append(static_cast<int>(TaskRole::CheckedRole));
+        }
+        if (item.task.startLine != task.startLine) {
+            changedRoles.append(static_cast<int>(TaskRole::StartLineRole));
+        }
+        if (item.task.endLine != task.endLine) {
+            changedRoles.append(static_cast<int>(TaskRole::EndLineRole));
+        }
+        item.task = task;
+        if (item.keepAnimationOnce) {
+            item.keepAnimationOnce = false;
+        } else if (item.animateCreation) {
+            item.animateCreation = false;
+            changedRoles.append(static_cast<int>(TaskRole::AnimateCreationRole));
+        }
+        if (!changedRoles.isEmpty()) {
+            emit dataChanged(index(i), index(i), changedRoles);
+        }
+    }
+    if (tasks.size() > m_items.size()) {
+        beginInsertRows(QModelIndex(), m_items.size(), tasks.size() - 1);
+        for (int i = m_items.size(); i < tasks.size(); ++i) {
+            TaskItem item;
+            item.task = tasks[i];
+            m_items.append(item);
+        }
+        endInsertRows();
+        emit countChanged();
+        return true;
+    }
+    if (tasks.size() < m_items.size()) {
+        beginRemoveRows(QModelIndex(), tasks.size(), m_items.size() - 1);
+        m_items.resize(tasks.size());
+        endRemoveRows();
+        emit countChanged();
+        return true;
+    }
+    return false;
+}
+
+void KanbanTaskModel::reverseTasks()
+{
+    QVector<KanbanTask> tasks;
+    tasks.reserve(m_items.size());
+    for (auto it = m_items.crbegin(); it != m_items.crend(); ++it) {
+        tasks.append(it->task);
+    }
+    setTasks(tasks);
+}
+
+int KanbanTaskModel::completedCount() const
+{
+    return std::count_if(m_items.cbegin(), m_items.cend(), [](const TaskItem &item) { return item.task.checked; });
+}
+
+int KanbanTaskModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent);
+    return m_items.size();
+}
+
+QVariant KanbanTaskModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_items.size()) {
+        return {};
+    }
+    const TaskItem &item = m_items[index.row()];
+    switch (static_cast<TaskRole>(role)) {
+    case TaskRole::TextRole:
+        return item.task.text;
+    case TaskRole::CheckedRole:
+        return item.task.checked;
+    case TaskRole::StartLineRole:
+        return item.task.startLine;
+    case TaskRole::EndLineRole:
+        return item.task.endLine;
+    case TaskRole::AnimateCreationRole:
+        return item.animateCreation;
+    }
+    return {};
+}
+
+QHash<int, QByteArray> KanbanTaskModel::roleNames() const
+{
+    return {
+        { static_cast<int>(TaskRole::TextRole), "taskText" },
+        { static_cast<int>(TaskRole::CheckedRole), "taskChecked" },
+        { static_cast<int>(TaskRole::StartLineRole), "taskStartLine" },
+        { static_cast<int>(TaskRole::EndLineRole), "taskEndLine" },
+        { static_cast<int>(TaskRole::AnimateCreationRole), "doNeedAnimateTaskCreation" },
+    };
+}
+
+QVariantMap KanbanTaskModel::get(int row) const
+{
+    if (row < 0 || row >= m_items.size()) {
+        return {};
+    }
+    const TaskItem &item = m_items[row];
+    return {
+        { QStringLiteral("taskText"), item.task.text },
+        { QStringLiteral("taskChecked"), item.task.checked },
+        { QStringLiteral("taskStartLine"), item.task.startLine },
+        { QStringLiteral("taskEndLine"), item.task.endLine },
+        { QStringLiteral("doNeedAnimateTaskCreation"), item.animateCreation },
+    };
+}
+
+void KanbanTaskModel::set(int row, const QVariantMap &task)
+{
+    if (row == m_items.size()) {
+        append(task);
+        return;
+    }
+    if (row < 0 || row > m_items.size()) {
+        qDebug() << __FUNCTION__ << "Invalid row" << row;
+        return;
+    }
+    m_items[row] = itemFromMap(task, m_items[row]);
+    emit dataChanged(index(row), index(row));
+}
+
+void KanbanTaskModel::insert(int row, const QVariantMap &task)
+{
+    if (row < 0 || row > m_items.size()) {
+        qDebug() << __FUNCTION__ << "Invalid row" << row;
+        return;
+    }
+    beginInsertRows(QModelIndex(), row, row);
+    m_items.insert(row, itemFromMap(task));
+    endInsertRows();
+    emit countChanged();
+}
+
+void KanbanTaskModel::append(const QVariantMap &task)
+{
+    insert(m_items.size(), task);
+}
+
+void KanbanTaskModel::remove(int row, int count)
+{
+    if (row < 0 || count < 1 || row + count > m_items.size()) {
+        qDebug() << __FUNCTION__ << "Invalid range" << row << count;
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    m_items.remove(row, count);
+    endRemoveRows();
+    emit countChanged();
+}
+
+void KanbanTaskModel::clear()
+{
+    if (m_items.isEmpty()) {
+        return;
+    }
+    beginResetModel();
+    m_items.clear();
+    endResetModel();
+    emit countChanged();
+}
+
+KanbanTaskModel::TaskItem KanbanTaskModel::itemFromMap(const QVariantMap &task, const TaskItem &base)
+{
+    TaskItem item = base;
+    item.task.text = task.value(QStringLiteral("taskText"), base.task.text).toString();
+    item.task.checked = task.value(QStringLiteral("taskChecked"), base.task.checked).toBool();
+    item.task.startLine = task.value(QStringLiteral("taskStartLine"), base.task.startLine).toInt();
+    item.task.endLine = task.value(QStringLiteral("taskEndLine"), base.task.endLine).toInt();
+    item.animateCreation = task.value(QStringLiteral("doNeedAnimateTaskCreation"), base.animateCreation).toBool();
+    item.keepAnimationOnce = item.animateCreation;
+    return item;
+}
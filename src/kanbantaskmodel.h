@@ -0,0 +1,73 @@
+#ifndef KANBANTASKMODEL_H
+#define KANBANTASKMODEL_H
+
+#include <QAbstractListModel>
+#include <QVariantMap>
+#include <QVector>
+
+struct KanbanTask
+{
+    QString text;
+    bool checked{ false };
+    int startLine{ 0 };
+    int endLine{ 0 };
+
+    bool operator==(const KanbanTask &other) const
+    {
+        return text == other.text && checked == other.checked && startLine == other.startLine && endLine == other.endLine;
+    }
+};
+
+/*!
+ * \brief The KanbanTaskModel class
+ * Tasks of one Kanban column. The board edits it right away through the
+ * ListModel style invokables, the editor then reconciles it with setTasks
+ * which only signals the rows that really changed
+ */
+class KanbanTaskModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
+public:
+    enum class TaskRole : std::uint16_t {
+        TextRole = Qt::UserRole + 1,
+        CheckedRole,
+        StartLineRole,
+        EndLineRole,
+        AnimateCreationRole,
+    };
+
+    explicit KanbanTaskModel(QObject *parent = nullptr);
+    bool setTasks(const QVector<KanbanTask> &tasks);
+    void reverseTasks();
+    int completedCount() const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE QVariantMap get(int row) const;
+    Q_INVOKABLE void set(int row, const QVariantMap &task);
+    Q_INVOKABLE void insert(int row, const QVariantMap &task);
+    Q_INVOKABLE void append(const QVariantMap &task);
+    Q_INVOKABLE void remove(int row, int count = 1);
+    Q_INVOKABLE void clear();
+
+signals:
+    void countChanged();
+
+private:
+    struct TaskItem
+    {
+        KanbanTask task;
+        bool animateCreation{ false };
+        // a task added from the board keeps animating through the first
+        // reconcile that follows it
+        bool keepAnimationOnce{ false };
+    };
+    QVector<TaskItem> m_items;
+
+    static TaskItem itemFromMap(const QVariantMap &task, const TaskItem &base = TaskItem{});
+};
+
+#endif // KANBANTASKMODEL_H
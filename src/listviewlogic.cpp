@@ -3,12 +3,18 @@
 #include "notelistmodel.h"
 #include "notelistdelegate.h"
 #include "dbmanager.h"
+#include "startuptrace.h"
 #include <QDebug>
 #include <QMessageBox>
 #include <QLineEdit>
 #include <QToolButton>
 #include "tagpool.h"
 #include <QTimer>
+#include <QScreen>
+#include <utility>
+#include <algorithm>
+
+#define NOTE_DATA_UPDATE_FALLBACK_INTERVAL 16
 
 static bool isInvalidCurrentNotesId(const QSet<int> &currentNotesId)
 {
@@ -34,7 +40,8 @@ ListViewLogic::ListViewLogic(NoteListView *noteView, NoteListModel *noteModel, Q
       m_dbManager{ dbManager },
       m_tagPool{ tagPool },
       m_needLoadSavedState{ 0 },
-      m_lastSelectedNotes{}
+      m_lastSelectedNotes{},
+      m_isLoadingNoteList{ false }
 {
     m_listDelegate = new NoteListDelegate(m_listView, tagPool, m_listView);
     m_listView->setItemDelegate(m_listDelegate);
@@ -45,18 +52,19 @@ ListViewLogic::ListViewLogic(NoteListView *noteView, NoteListModel *noteModel, Q
     connect(m_listModel, &NoteListModel::rowsMovedC, m_listView, &NoteListView::rowsMoved);
     // note pressed
     connect(m_listView, &NoteListView::notePressed, this, [this](const QModelIndexList &indexes) { onNotePressed(indexes); });
-    connect(m_listView, &NoteListView::addTagRequested, this, &ListViewLogic::onAddTagRequest);
-    connect(m_listView, &NoteListView::removeTagRequested, this, &ListViewLogic::onRemoveTagRequest);
+    connect(m_listView, &NoteListView::addTagRequested, this, &ListViewLogic::onAddTagToNotesRequest);
+    connect(m_listView, &NoteListView::removeTagRequested, this, &ListViewLogic::onRemoveTagFromNotesRequest);
 
     connect(this, &ListViewLogic::requestAddTagDb, dbManager, &DBManager::addNoteToTag, Qt::QueuedConnection);
-    connect(this, &ListViewLogic::requestRemoveTagDb, dbManager, &DBManager::removeNoteFromTag, Qt::QueuedConnection);
-    connect(this, &ListViewLogic::requestRemoveNoteDb, dbManager, &DBManager::removeNote, Qt::QueuedConnection);
-    connect(this, &ListViewLogic::requestMoveNoteDb, dbManager, &DBManager::moveNode, Qt::QueuedConnection);
+    connect(this, &ListViewLogic::requestAddTagToNotesDb, dbManager, &DBManager::addNotesToTag, Qt::QueuedConnection);
+    connect(this, &ListViewLogic::requestRemoveTagFromNotesDb, dbManager, &DBManager::removeNotesFromTag, Qt::QueuedConnection);
+    connect(this, &ListViewLogic::requestRemoveNotesDb, dbManager, &DBManager::removeNotes, Qt::QueuedConnection);
+    connect(this, &ListViewLogic::requestMoveNotesDb, dbManager, &DBManager::moveNotes, Qt::QueuedConnection);
     connect(this, &ListViewLogic::requestSearchInDb, dbManager, &DBManager::searchForNotes, Qt::QueuedConnection);
     connect(this, &ListViewLogic::requestClearSearchDb, dbManager, &DBManager::clearSearch, Qt::QueuedConnection);
     connect(m_listModel, &NoteListModel::requestUpdatePinnedRelPos, dbManager, &DBManager::updateRelPosPinnedNote, Qt::QueuedConnection);
     connect(m_listModel, &NoteListModel::requestUpdatePinnedRelPosAN, dbManager, &DBManager::updateRelPosPinnedNoteAN, Qt::QueuedConnection);
-    connect(m_listModel, &NoteListModel::requestUpdatePinned, dbManager, &DBManager::setNoteIsPinned, Qt::QueuedConnection);
+    connect(m_listModel, &NoteListModel::requestUpdatePinned, dbManager, &DBManager::setNotesIsPinned, Qt::QueuedConnection);
 
     connect(m_listView, &NoteListView::deleteNoteRequested, this, &ListViewLogic::deleteNoteRequestedI);
     connect(m_listView, &NoteListView::restoreNoteRequested, this, &ListViewLogic::restoreNotesRequestedI);
@@ -70,8 +78,13 @@ ListViewLogic::ListViewLogic(NoteListView *noteView, NoteListModel *noteModel, Q
     connect(m_listModel, &QAbstractItemModel::rowsInserted, this, &ListViewLogic::updateListViewLabel);
     connect(m_listModel, &QAbstractItemModel::rowsRemoved, this, &ListViewLogic::updateListViewLabel);
     connect(m_listView, &NoteListView::newNoteRequested, this, &ListViewLogic::requestNewNote);
-    connect(m_listView, &NoteListView::moveNoteRequested, this, &ListViewLogic::moveNoteRequested);
+    connect(m_listView, &NoteListView::moveNotesRequested, this, &ListViewLogic::moveNotesRequested);
     connect(m_listModel, &NoteListModel::rowCountChanged, this, &ListViewLogic::onRowCountChanged);
+    connect(m_listModel, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex &, const QModelIndex &, const QList<int> &roles) {
+        if (roles.isEmpty() || roles.contains(NoteListModel::NoteTagsList)) {
+            m_listView->updateUniformItemSizes();
+        }
+    });
     connect(m_listView, &NoteListView::doubleClicked, this, &ListViewLogic::onNoteDoubleClicked);
     connect(m_listView, &NoteListView::setPinnedNoteRequested, this, &ListViewLogic::onSetPinnedNoteRequested);
     connect(m_listView, &NoteListView::pinnedCollapseChanged, this, &ListViewLogic::onRowCountChanged);
@@ -96,6 +109,14 @@ ListViewLogic::ListViewLogic(NoteListView *noteView, NoteListModel *noteModel, Q
     connect(m_listModel, &NoteListModel::rowsInsertedC, m_listView, &NoteListView::onRowsInserted);
     connect(m_listModel, &NoteListModel::selectNotes, this, &ListViewLogic::selectNotes);
     connect(m_listView, &NoteListView::noteListViewClicked, this, &ListViewLogic::onListViewClicked);
+    // edits of the open note reach the list at most once per display frame
+    int updateInterval = NOTE_DATA_UPDATE_FALLBACK_INTERVAL;
+    if (m_listView->screen() != nullptr && m_listView->screen()->refreshRate() > 0) {
+        updateInterval = qMax(1, qRound(1000.0 / m_listView->screen()->refreshRate()));
+    }
+    m_noteDataUpdateTimer.setSingleShot(true);
+    m_noteDataUpdateTimer.setInterval(updateInterval);
+    connect(&m_noteDataUpdateTimer, &QTimer::timeout, this, &ListViewLogic::applyPendingNoteData);
 }
 
 void ListViewLogic::selectNote(const QModelIndex &noteIndex)
@@ -115,18 +136,15 @@ void ListViewLogic::moveNoteToTop(const NodeData &note)
 {
     QModelIndex noteIndex = m_listModel->getNoteIndex(note.id());
     if (noteIndex.isValid()) {
-        m_listView->scrollToTop();
-
-        // move the current selected note to the top (unless it's already there)
-        QModelIndex destinationIndex;
-        if (note.isPinnedNote()) {
-            destinationIndex = m_listModel->index(0);
-        } else {
-            destinationIndex = m_listModel->index(m_listModel->getFirstUnpinnedNote().row());
-        }
-        if (noteIndex == destinationIndex) {
+        // nothing to do while typing into a note that is already at the top
+        int destinationRow = note.isPinnedNote() ? 0 : m_listModel->getFirstUnpinnedNote().row();
+        if (noteIndex.row() == destinationRow) {
             return;
         }
+        m_listView->scrollToTop();
+
+        // move the current selected note to the top
+        QModelIndex destinationIndex = m_listModel->index(destinationRow);
         m_listModel->moveRow(noteIndex, noteIndex.row(), destinationIndex, destinationIndex.row());
 
         // update the current item
@@ -137,31 +155,65 @@ void ListViewLogic::moveNoteToTop(const NodeData &note)
     }
 }
 
+/*!
+ * \brief ListViewLogic::setNoteData
+ * Called on every edit of the open note, the list is updated on the next
+ * frame with whatever the latest data is by then
+ */
 void ListViewLogic::setNoteData(const NodeData &note)
 {
-    QModelIndex noteIndex = m_listModel->getNoteIndex(note.id());
-    if (noteIndex.isValid()) {
+    auto it = m_pendingNoteData.find(note.id());
+    if (it != m_pendingNoteData.end() && it->isContentLoaded() && !note.isContentLoaded()) {
+        // keep the content from an earlier update in the same frame
+        auto content = it->content();
+        *it = note;
+        it->setContent(content);
+        it->setIsContentLoaded(true);
+    } else {
+        m_pendingNoteData.insert(note.id(), note);
+    }
+    if (!m_noteDataUpdateTimer.isActive()) {
+        m_noteDataUpdateTimer.start();
+    }
+}
+
+void ListViewLogic::applyPendingNoteData()
+{
+    m_noteDataUpdateTimer.stop();
+    auto pendingNoteData = std::exchange(m_pendingNoteData, {});
+    for (const auto &note : std::as_const(pendingNoteData)) {
+        QModelIndex noteIndex = m_listModel->getNoteIndex(note.id());
+        if (!noteIndex.isValid()) {
+            continue;
+        }
         QMap<int, QVariant> dataValue;
         auto wasTemp = noteIndex.data(NoteListModel::NoteIsTemp).toBool();
-        dataValue[NoteListModel::NoteContent] = QVariant::fromValue(note.content());
+        // the editor only hands out its content once it has been read back
+        if (note.isContentLoaded()) {
+            dataValue[NoteListModel::NoteContent] = QVariant::fromValue(note.content());
+        }
         dataValue[NoteListModel::NoteFullTitle] = QVariant::fromValue(note.fullTitle());
+        dataValue[NoteListModel::NotePreview] = QVariant::fromValue(note.preview());
         dataValue[NoteListModel::NoteLastModificationDateTime] = QVariant::fromValue(note.lastModificationdateTime());
         dataValue[NoteListModel::NoteIsTemp] = QVariant::fromValue(note.isTempNote());
         dataValue[NoteListModel::NoteScrollbarPos] = QVariant::fromValue(note.scrollBarPosition());
         m_listModel->setItemData(noteIndex, dataValue);
-        if (wasTemp) {
-            auto tagIds = noteIndex.data(NoteListModel::NoteTagsList).value<QSet<int>>();
+        // tags added to a temp note only live in the list model, they are
+        // written once the note has been saved to the database. An update
+        // for a note that is still temp must not write them, the note row
+        // doesn't exist yet and the next update would write them again.
+        if (wasTemp && !note.isTempNote()) {
+            auto tagIds = noteIndex.data(NoteListModel::NoteTagsList).value<TagIdList>();
             for (const auto tagId : std::as_const(tagIds)) {
                 emit requestAddTagDb(note.id(), tagId);
             }
         }
-    } else {
-        qDebug() << "ListViewLogic::moveNoteToTop : Note is not in list";
     }
 }
 
 void ListViewLogic::onNoteEditClosed(const NodeData &note, bool selectNext)
 {
+    applyPendingNoteData();
     if (note.isTempNote()) {
         QModelIndex noteIndex = m_listModel->getNoteIndex(note.id());
         if (noteIndex.isValid()) {
@@ -277,9 +329,15 @@ void ListViewLogic::loadNoteListModel(const QVector<NodeData> &noteList, const L
         m_listDelegate->setIsInAllNotes(false);
     }
 
+    // setListNote may insert and remove rows one range at a time, the label is refreshed once below
+    m_isLoadingNoteList = true;
     m_listModel->setListNote(noteList, m_listViewInfo);
+    m_isLoadingNoteList = false;
     m_listView->setListViewInfo(m_listViewInfo);
     updateListViewLabel();
+    if (StartupTrace::instance()->markOnce(QStringLiteral("first list load"))) {
+        StartupTrace::instance()->markOnFirstPaint(m_listView->viewport(), QStringLiteral("first list paint"));
+    }
 
     if ((!m_listViewInfo.isInTag) && m_listViewInfo.parentFolderId == TRASH_FOLDER_ID) {
         emit setNewNoteButtonVisible(false);
@@ -335,52 +393,106 @@ void ListViewLogic::loadNoteListModel(const QVector<NodeData> &noteList, const L
     selectFirstNote();
 }
 
-void ListViewLogic::onAddTagRequest(const QModelIndex &index, int tagId)
+void ListViewLogic::onAddTagToNotesRequest(const QSet<int> &noteIds, int tagId)
 {
-    if (index.isValid()) {
-        auto noteId = index.data(NoteListModel::NoteID).toInt();
-        auto isTemp = index.data(NoteListModel::NoteIsTemp).toBool();
-        if (!isTemp) {
-            emit requestAddTagDb(noteId, tagId);
+    QSet<int> savedNoteIds;
+    for (const auto noteId : noteIds) {
+        auto index = m_listModel->getNoteIndex(noteId);
+        if (!index.isValid()) {
+            continue;
         }
-        auto tagIds = index.data(NoteListModel::NoteTagsList).value<QSet<int>>();
-        tagIds.insert(tagId);
-        m_listModel->setData(index, QVariant::fromValue(tagIds), NoteListModel::NoteTagsList);
-        m_listView->closePersistentEditorC(index);
-        m_listView->openPersistentEditorC(index);
-        emit noteTagListChanged(noteId, tagIds);
-    } else {
-        qDebug() << __FUNCTION__ << "index is not valid";
+        if (!index.data(NoteListModel::NoteIsTemp).toBool()) {
+            savedNoteIds.insert(noteId);
+        }
+        updateNoteTagList(index, tagId, true);
+    }
+    if (!savedNoteIds.isEmpty()) {
+        emit requestAddTagToNotesDb(savedNoteIds, tagId);
     }
 }
 
-void ListViewLogic::onAddTagRequestD(int noteId, int tagId)
+void ListViewLogic::onRemoveTagFromNotesRequest(const QSet<int> &noteIds, int tagId)
 {
-    auto index = m_listModel->getNoteIndex(noteId);
-    onAddTagRequest(index, tagId);
+    QSet<int> savedNoteIds;
+    for (const auto noteId : noteIds) {
+        auto index = m_listModel->getNoteIndex(noteId);
+        if (!index.isValid()) {
+            continue;
+        }
+        if (!index.data(NoteListModel::NoteIsTemp).toBool()) {
+            savedNoteIds.insert(noteId);
+        }
+        updateNoteTagList(index, tagId, false);
+    }
+    if (!savedNoteIds.isEmpty()) {
+        emit requestRemoveTagFromNotesDb(savedNoteIds, tagId);
+    }
 }
 
-void ListViewLogic::onNoteMovedOut(int nodeId, int targetId)
+void ListViewLogic::updateNoteTagList(const QModelIndex &index, int tagId, bool isAdded)
 {
-    auto index = m_listModel->getNoteIndex(nodeId);
-    if (index.isValid()) {
-        if ((!m_listViewInfo.isInTag && m_listViewInfo.parentFolderId != ROOT_FOLDER_ID && m_listViewInfo.parentFolderId != targetId)
-            || targetId == TRASH_FOLDER_ID) {
-            selectNoteDown();
-            m_listModel->removeNotes({ index });
-            if (m_listModel->rowCount() == 0) {
-                emit closeNoteEditor();
-            }
-        } else {
-            NodeData note;
-            QMetaObject::invokeMethod(m_dbManager, "getNode", Qt::BlockingQueuedConnection, Q_RETURN_ARG(NodeData, note), Q_ARG(int, nodeId));
-            if (note.id() != INVALID_NODE_ID) {
-                m_listView->closePersistentEditorC(index);
-                m_listModel->setNoteData(index, note);
-                m_listView->openPersistentEditorC(index);
-            } else {
-                qDebug() << __FUNCTION__ << "Note id" << nodeId << "not found!";
+    auto noteId = index.data(NoteListModel::NoteID).toInt();
+    auto tagIds = index.data(NoteListModel::NoteTagsList).value<TagIdList>();
+    auto it = std::lower_bound(tagIds.begin(), tagIds.end(), tagId);
+    bool isPresent = it != tagIds.end() && *it == tagId;
+    if (isAdded && !isPresent) {
+        tagIds.insert(it, tagId);
+    } else if (!isAdded && isPresent) {
+        tagIds.erase(it);
+    }
+    m_listModel->setData(index, QVariant::fromValue(tagIds), NoteListModel::NoteTagsList);
+    m_listView->closePersistentEditorC(index);
+    m_listView->openPersistentEditorC(index);
+    emit noteTagListChanged(noteId, QSet<int>(tagIds.cbegin(), tagIds.cend()));
+}
+
+/*!
+ * \brief ListViewLogic::onNotesMovedOut
+ * Notes that leave the current view are removed in one go, the others only
+ * need their parent updated so the target folder is fetched once
+ */
+void ListViewLogic::onNotesMovedOut(const QSet<int> &noteIds, int targetId)
+{
+    applyPendingNoteData();
+    QModelIndexList indexes;
+    for (const auto noteId : noteIds) {
+        auto index = m_listModel->getNoteIndex(noteId);
+        if (index.isValid()) {
+            indexes.append(index);
+        }
+    }
+    if (indexes.isEmpty()) {
+        return;
+    }
+    if ((!m_listViewInfo.isInTag && m_listViewInfo.parentFolderId != ROOT_FOLDER_ID && m_listViewInfo.parentFolderId != targetId)
+        || targetId == TRASH_FOLDER_ID) {
+        selectNoteDown();
+        bool needClose = false;
+        if (m_listModel->rowCount() == indexes.size()) {
+            needClose = true;
+        }
+        m_listModel->removeNotes(indexes);
+        if (needClose) {
+            emit closeNoteEditor();
+        }
+    } else {
+        NodeData target;
+        QMetaObject::invokeMethod(m_dbManager, "getNode", Qt::BlockingQueuedConnection, Q_RETURN_ARG(NodeData, target), Q_ARG(int, targetId));
+        if (target.nodeType() != NodeData::Type::Folder) {
+            qDebug() << __FUNCTION__ << "Folder id" << targetId << "not found!";
+            return;
+        }
+        for (const auto &index : std::as_const(indexes)) {
+            auto note = m_listModel->getNote(index);
+            if (note.parentId() == targetId) {
+                continue;
             }
+            note.setParentId(targetId);
+            note.setParentName(target.fullTitle());
+            note.setAbsolutePath(target.absolutePath() + PATH_SEPARATOR + QString::number(note.id()));
+            m_listView->closePersistentEditorC(index);
+            m_listModel->setNoteData(index, note);
+            m_listView->openPersistentEditorC(index);
         }
     }
 }
@@ -450,25 +562,6 @@ void ListViewLogic::selectNotes(const QModelIndexList &indexes)
     onNotePressed(indexes);
 }
 
-void ListViewLogic::onRemoveTagRequest(const QModelIndex &index, int tagId)
-{
-    if (index.isValid()) {
-        auto noteId = index.data(NoteListModel::NoteID).toInt();
-        auto isTemp = index.data(NoteListModel::NoteIsTemp).toBool();
-        if (!isTemp) {
-            emit requestRemoveTagDb(noteId, tagId);
-        }
-        auto tagIds = index.data(NoteListModel::NoteTagsList).value<QSet<int>>();
-        tagIds.remove(tagId);
-        m_listModel->setData(index, QVariant::fromValue(tagIds), NoteListModel::NoteTagsList);
-        m_listView->closePersistentEditorC(index);
-        m_listView->openPersistentEditorC(index);
-        emit noteTagListChanged(noteId, tagIds);
-    } else {
-        qDebug() << __FUNCTION__ << "index is not valid";
-    }
-}
-
 /*!
  * \brief MainWindow::onNotePressed
  * When clicking on a note in the scrollArea:
@@ -497,20 +590,23 @@ void ListViewLogic::onNotePressed(const QModelIndexList &indexes)
 
 void ListViewLogic::deleteNoteRequestedI(const QModelIndexList &indexes)
 {
+    applyPendingNoteData();
     if (!indexes.empty()) {
+        // the list already holds each note's parent, the database decides
+        // again per note whether to trash or delete it
         bool isInTrash = false;
-        QVector<NodeData> needDelete;
+        QSet<int> needDelete;
         QModelIndexList needDeleteI;
         for (const auto &index : std::as_const(indexes)) {
             if (index.isValid()) {
-                auto id = index.data(NoteListModel::NoteID).toInt();
-                NodeData note;
-                QMetaObject::invokeMethod(m_dbManager, "getNode", Qt::BlockingQueuedConnection, Q_RETURN_ARG(NodeData, note), Q_ARG(int, id));
+                const auto &note = m_listModel->getNote(index);
                 if (note.parentId() == TRASH_FOLDER_ID) {
                     isInTrash = true;
                 }
                 needDeleteI.append(index);
-                needDelete.append(note);
+                if (!note.isTempNote()) {
+                    needDelete.insert(note.id());
+                }
             }
         }
         if (isInTrash) {
@@ -527,8 +623,8 @@ void ListViewLogic::deleteNoteRequestedI(const QModelIndexList &indexes)
                 if (needClose) {
                     emit closeNoteEditor();
                 }
-                for (const auto &note : std::as_const(needDelete)) {
-                    emit requestRemoveNoteDb(note);
+                if (!needDelete.isEmpty()) {
+                    emit requestRemoveNotesDb(needDelete);
                 }
             }
         } else {
@@ -541,8 +637,8 @@ void ListViewLogic::deleteNoteRequestedI(const QModelIndexList &indexes)
             if (needClose) {
                 emit closeNoteEditor();
             }
-            for (const auto &note : std::as_const(needDelete)) {
-                emit requestRemoveNoteDb(note);
+            if (!needDelete.isEmpty()) {
+                emit requestRemoveNotesDb(needDelete);
             }
         }
     }
@@ -554,14 +650,12 @@ void ListViewLogic::restoreNotesRequestedI(const QModelIndexList &indexes)
     QSet<int> needRestored;
     for (const auto &index : std::as_const(indexes)) {
         if (index.isValid()) {
-            auto id = index.data(NoteListModel::NoteID).toInt();
-            NodeData note;
-            QMetaObject::invokeMethod(m_dbManager, "getNode", Qt::BlockingQueuedConnection, Q_RETURN_ARG(NodeData, note), Q_ARG(int, id));
+            const auto &note = m_listModel->getNote(index);
             if (note.parentId() == TRASH_FOLDER_ID) {
                 needRestoredI.append(index);
                 needRestored.insert(note.id());
             } else {
-                qDebug() << "Note id" << id << "is currently not in Trash";
+                qDebug() << "Note id" << note.id() << "is currently not in Trash";
             }
         }
     }
@@ -573,16 +667,16 @@ void ListViewLogic::restoreNotesRequestedI(const QModelIndexList &indexes)
     if (needClose) {
         emit closeNoteEditor();
     }
-    NodeData defaultNotesFolder;
-    QMetaObject::invokeMethod(m_dbManager, "getNode", Qt::BlockingQueuedConnection, Q_RETURN_ARG(NodeData, defaultNotesFolder),
-                              Q_ARG(int, DEFAULT_NOTES_FOLDER_ID));
-    for (const auto &id : std::as_const(needRestored)) {
-        emit requestMoveNoteDb(id, defaultNotesFolder);
+    if (!needRestored.isEmpty()) {
+        emit requestMoveNotesDb(needRestored, DEFAULT_NOTES_FOLDER_ID);
     }
 }
 
 void ListViewLogic::updateListViewLabel()
 {
+    if (m_isLoadingNoteList) {
+        return;
+    }
     QString l1;
     QString l2;
     if ((!m_listViewInfo.isInTag) && m_listViewInfo.parentFolderId == ROOT_FOLDER_ID) {
@@ -613,8 +707,26 @@ void ListViewLogic::updateListViewLabel()
     emit listViewLabelChanged(l1, l2);
 }
 
+/*!
+ * \brief ListViewLogic::loadNoteListSnapshot
+ * Shows the list page saved in the startup snapshot. No note gets selected
+ * and the editor stays untouched; loadNoteListModel replaces the rows and
+ * restores the saved selection once the database answers.
+ */
+void ListViewLogic::loadNoteListSnapshot(const QVector<NodeData> &noteList, const ListViewInfo &inf, const QString &label1, const QString &label2)
+{
+    auto currentNotesId = m_listViewInfo.currentNotesId;
+    m_listViewInfo = inf;
+    m_listViewInfo.currentNotesId = currentNotesId;
+    m_listDelegate->setIsInAllNotes((!m_listViewInfo.isInTag) && m_listViewInfo.parentFolderId == ROOT_FOLDER_ID);
+    m_listModel->setListNote(noteList, m_listViewInfo);
+    m_listView->setListViewInfo(m_listViewInfo);
+    emit listViewLabelChanged(label1, label2);
+}
+
 void ListViewLogic::onRowCountChanged()
 {
+    m_listView->updateUniformItemSizes();
     m_listView->closeAllEditor();
     m_listDelegate->clearSizeMap();
     for (int i = 0; i < m_listModel->rowCount(); ++i) {
@@ -7,6 +7,8 @@
 #include "dbmanager.h"
 #include "editorsettingsoptions.h"
 #include <QModelIndex>
+#include <QHash>
+#include <QTimer>
 
 class NoteListView;
 class NoteListModel;
@@ -31,6 +33,7 @@ public:
     void setLastSavedState(const QSet<int> &lastSelectedNotes, int needLoadSavedState = 2);
     void requestLoadSavedState(int needLoadSavedState);
     void selectAllNotes();
+    void loadNoteListSnapshot(const QVector<NodeData> &noteList, const ListViewInfo &inf, const QString &label1, const QString &label2);
 public slots:
     void moveNoteToTop(const NodeData &note);
     void setNoteData(const NodeData &note);
@@ -40,8 +43,8 @@ public slots:
     void selectNoteDown();
     void onSearchEditTextChanged(const QString &keyword);
     void clearSearch(bool createNewNote = false, int scrollToId = INVALID_NODE_ID);
-    void onAddTagRequestD(int noteId, int tagId);
-    void onNoteMovedOut(int nodeId, int targetId);
+    void onAddTagToNotesRequest(const QSet<int> &noteIds, int tagId);
+    void onNotesMovedOut(const QSet<int> &noteIds, int targetId);
     void setLastSelectedNote();
     void loadLastSelectedNoteRequested();
     void onNotesListInFolderRequested(int parentID, bool isRecursive, bool newNote, int scrollToId);
@@ -50,9 +53,10 @@ public slots:
 signals:
     void showNotesInEditor(const QVector<NodeData> &notesData);
     void requestAddTagDb(int noteId, int tagId);
-    void requestRemoveTagDb(int noteId, int tagId);
-    void requestRemoveNoteDb(const NodeData &noteData);
-    void requestMoveNoteDb(int noteId, const NodeData &targetFolder);
+    void requestAddTagToNotesDb(const QSet<int> &noteIds, int tagId);
+    void requestRemoveTagFromNotesDb(const QSet<int> &noteIds, int tagId);
+    void requestRemoveNotesDb(const QSet<int> &noteIds);
+    void requestMoveNotesDb(const QSet<int> &noteIds, int targetId);
     void requestHighlightSearch();
     void closeNoteEditor();
     void noteTagListChanged(int noteId, const QSet<int> &tagIds);
@@ -60,7 +64,7 @@ signals:
     void requestClearSearchDb(const ListViewInfo &inf);
     void requestClearSearchUI();
     void requestNewNote();
-    void moveNoteRequested(int id, int target);
+    void moveNotesRequested(const QSet<int> &noteIds, int target);
     void listViewLabelChanged(const QString &label1, const QString &label2);
     void setNewNoteButtonVisible(bool visible);
     void requestNotesListInFolder(int parentID, bool isRecursive, bool newNote, int scrollToId);
@@ -68,8 +72,7 @@ signals:
 
 private slots:
     void loadNoteListModel(const QVector<NodeData> &noteList, const ListViewInfo &inf);
-    void onAddTagRequest(const QModelIndex &index, int tagId);
-    void onRemoveTagRequest(const QModelIndex &index, int tagId);
+    void onRemoveTagFromNotesRequest(const QSet<int> &noteIds, int tagId);
     void onNotePressed(const QModelIndexList &indexes);
     void deleteNoteRequestedI(const QModelIndexList &indexes);
     void restoreNotesRequestedI(const QModelIndexList &indexes);
@@ -79,6 +82,10 @@ private slots:
     void onSetPinnedNoteRequested(const QModelIndexList &indexes, bool isPinned);
     void onListViewClicked();
 
+private:
+    void updateNoteTagList(const QModelIndex &index, int tagId, bool isAdded);
+    void applyPendingNoteData();
+
 private:
     NoteListView *m_listView;
     NoteListModel *m_listModel;
@@ -92,6 +99,9 @@ private:
 
     int m_needLoadSavedState;
     QSet<int> m_lastSelectedNotes;
+    bool m_isLoadingNoteList;
+    QHash<int, NodeData> m_pendingNoteData;
+    QTimer m_noteDataUpdateTimer;
 };
 
 #endif // LISTVIEWLOGIC_H
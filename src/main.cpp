@@ -6,12 +6,22 @@
 
 #include "mainwindow.h"
 #include "singleinstance.h"
+#include "startuptrace.h"
 #include <QApplication>
 #include <QFontDatabase>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
 
 int main(int argc, char *argv[])
 {
+    // tracing has to be on before the first mark, QApplication::arguments() isn't available yet
+    if (std::any_of(argv, argv + argc, [](const char *arg) { return qstrcmp(arg, "--benchmark-startup") == 0; })) {
+        StartupTrace::instance()->setEnabled(true);
+    }
+    StartupTrace::instance()->mark(QStringLiteral("main"));
     QApplication app(argc, argv);
+    StartupTrace::instance()->mark(QStringLiteral("application created"));
     // Set application information
     QApplication::setApplicationName("Notes");
     QApplication::setApplicationVersion(APP_VERSION);
@@ -83,18 +93,53 @@ int main(int argc, char *argv[])
     QFontDatabase::addApplicationFont(":/fonts/iaquattro/iAWriterQuattroS-Bold.ttf");
     QFontDatabase::addApplicationFont(":/fonts/iaquattro/iAWriterQuattroS-BoldItalic.ttf");
 
+    StartupTrace::instance()->mark(QStringLiteral("fonts loaded"));
+
+    // --benchmark-startup [report file]: launch, wait for the first note list
+    // paint, print the startup timings and quit
+    const QStringList arguments = QApplication::arguments();
+    const int benchmarkIndex = arguments.indexOf(QStringLiteral("--benchmark-startup"));
+    const bool isBenchmarkingStartup = benchmarkIndex != -1;
+    const QString benchmarkReportPath =
+            (isBenchmarkingStartup && benchmarkIndex + 1 < arguments.size() && !arguments.at(benchmarkIndex + 1).startsWith(QStringLiteral("--")))
+            ? arguments.at(benchmarkIndex + 1)
+            : QString();
+
     // Prevent many instances of the app to be launched
     QString name = "com.awsomeness.notes";
     SingleInstance instance;
-    if (SingleInstance::hasPrevious(name)) {
-        return EXIT_SUCCESS;
+    if (!isBenchmarkingStartup) {
+        if (SingleInstance::hasPrevious(name)) {
+            return EXIT_SUCCESS;
+        }
+
+        instance.listen(name);
     }
 
-    instance.listen(name);
+    if (isBenchmarkingStartup) {
+        QObject::connect(StartupTrace::instance(), &StartupTrace::marked, &app, [benchmarkReportPath](const QString &phase) {
+            if (phase != QStringLiteral("first list paint")) {
+                return;
+            }
+            QString report = StartupTrace::instance()->report();
+            QTextStream(stdout) << report;
+            if (!benchmarkReportPath.isEmpty()) {
+                QFile reportFile(benchmarkReportPath);
+                if (reportFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+                    QTextStream(&reportFile) << report;
+                } else {
+                    qWarning() << "Can't write startup report to" << benchmarkReportPath;
+                }
+            }
+            QCoreApplication::exit(EXIT_SUCCESS);
+        });
+    }
 
     // Create and Show the app
     MainWindow w;
+    StartupTrace::instance()->mark(QStringLiteral("main window constructed"));
     w.show();
+    StartupTrace::instance()->mark(QStringLiteral("main window shown"));
 
     // Bring the Notes window to the front
     QObject::connect(&instance, &SingleInstance::newInstance, &w, [&]() { (&w)->setMainWindowVisibility(true); });
@@ -12,6 +12,8 @@
 #include "noteeditorlogic.h"
 #include "tagpool.h"
 #include "splitterstyle.h"
+#include "startupsnapshot.h"
+#include "startuptrace.h"
 #include "editorsettingsoptions.h"
 #include "fontloader.h"
 #include <utils.h>
@@ -31,6 +33,21 @@
 #include <QSqlQuery>
 
 #define DEFAULT_DATABASE_NAME "default_database"
+#define STARTUP_SNAPSHOT_NOTE_COUNT 50
+#define STARTUP_SNAPSHOT_IDLE_DELAY 10000
+
+static QJsonObject qmlThemeData(Theme::Value theme)
+{
+    switch (theme) {
+    case Theme::Dark:
+        return QJsonObject{ { "theme", QStringLiteral("Dark") }, { "backgroundColor", "#191919" } };
+    case Theme::Sepia:
+        return QJsonObject{ { "theme", QStringLiteral("Sepia") }, { "backgroundColor", "#fbf0d9" } };
+    case Theme::Light:
+    default:
+        return QJsonObject{ { "theme", QStringLiteral("Light") }, { "backgroundColor", "#f7f7f7" } };
+    }
+}
 
 /*!
  * \brief MainWindow::MainWindow
@@ -121,6 +138,7 @@ MainWindow::MainWindow(QWidget *parent)
       m_localLicenseData(nullptr),
       m_subscriptionWindowQuickView(nullptr),
       m_subscriptionWindowWidget(new QWidget(this)),
+      m_subscriptionWindow(nullptr),
       m_purchaseDataAlt1(QStringLiteral("https://raw.githubusercontent.com/nuttyartist/notes/"
                                         "master/notes_purchase_data.json")),
       m_purchaseDataAlt2(QStringLiteral("https://www.rubymamistvalove.com/notes/notes_purchase_data.json")),
@@ -137,23 +155,41 @@ MainWindow::MainWindow(QWidget *parent)
       m_checkUpdatesTimer(new QTimer(this))
 {
     m_ui->setupUi(this);
+    StartupTrace::instance()->mark(QStringLiteral("setupUi"));
     setupMainWindow();
+    StartupTrace::instance()->mark(QStringLiteral("setupMainWindow"));
     setupFonts();
+    StartupTrace::instance()->mark(QStringLiteral("setupFonts"));
     setupSplitter();
+    StartupTrace::instance()->mark(QStringLiteral("setupSplitter"));
     setupSearchEdit();
+    StartupTrace::instance()->mark(QStringLiteral("setupSearchEdit"));
     setupEditorSettings();
+    StartupTrace::instance()->mark(QStringLiteral("setupEditorSettings"));
     setupKeyboardShortcuts();
+    StartupTrace::instance()->mark(QStringLiteral("setupKeyboardShortcuts"));
     setupDatabases();
+    StartupTrace::instance()->mark(QStringLiteral("setupDatabases"));
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
     setupSubscrirptionWindow();
+    StartupTrace::instance()->mark(QStringLiteral("setupSubscrirptionWindow"));
     setupKanbanView();
+    StartupTrace::instance()->mark(QStringLiteral("setupKanbanView"));
 #endif
     setupGlobalSettingsMenu();
+    StartupTrace::instance()->mark(QStringLiteral("setupGlobalSettingsMenu"));
     setupModelView();
+    StartupTrace::instance()->mark(QStringLiteral("setupModelView"));
     setupTextEdit();
+    StartupTrace::instance()->mark(QStringLiteral("setupTextEdit"));
     restoreStates();
+    StartupTrace::instance()->mark(QStringLiteral("restoreStates"));
     setupButtons();
+    StartupTrace::instance()->mark(QStringLiteral("setupButtons"));
     setupSignalsSlots();
+    StartupTrace::instance()->mark(QStringLiteral("setupSignalsSlots"));
+    loadStartupSnapshot();
+    StartupTrace::instance()->mark(QStringLiteral("loadStartupSnapshot"));
 #if defined(UPDATE_CHECKER)
     autoCheckForUpdates();
     connect(&m_checkUpdatesTimer, &QTimer::timeout, this, &MainWindow::autoCheckForUpdates);
@@ -163,16 +199,18 @@ MainWindow::MainWindow(QWidget *parent)
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
     checkProVersion();
 #endif
-
-    QTimer::singleShot(200, this, SLOT(initData()));
 }
 
 /*!
  * \brief MainWindow::initData
- * Init the data from database and select the first note if there is one
+ * Init the data from database and select the first note if there is one.
+ * Runs once DBManager reports the database as opened; from there each step
+ * is triggered by the previous one: the tree arrives, the saved folder gets
+ * selected, its notes arrive and the saved note is opened in the editor.
  */
 void MainWindow::initData()
 {
+    StartupTrace::instance()->mark(QStringLiteral("initData"));
     QFileInfo fi(m_settingsDatabase->fileName());
     QDir dir(fi.absolutePath());
     QString oldNoteDBPath = QStringLiteral("%1/Notes.ini").arg(dir.path());
@@ -785,7 +823,7 @@ void MainWindow::setupSignalsSlots()
 #endif
 
     // MainWindow <-> DBManager
-    connect(this, &MainWindow::requestNodesTree, m_dbManager, &DBManager::onNodeTagTreeRequested, Qt::BlockingQueuedConnection);
+    connect(this, &MainWindow::requestNodesTree, m_dbManager, &DBManager::onNodeTagTreeRequested, Qt::QueuedConnection);
     connect(this, &MainWindow::requestRestoreNotes, m_dbManager, &DBManager::onRestoreNotesRequested, Qt::BlockingQueuedConnection);
     connect(this, &MainWindow::requestImportNotes, m_dbManager, &DBManager::onImportNotesRequested, Qt::BlockingQueuedConnection);
     connect(this, &MainWindow::requestExportNotes, m_dbManager, &DBManager::onExportNotesRequested, Qt::BlockingQueuedConnection);
@@ -817,21 +855,26 @@ void MainWindow::setupSignalsSlots()
         m_ui->frameRightTop->show();
     });
     connect(m_listViewLogic, &ListViewLogic::requestClearSearchUI, this, &MainWindow::clearSearch);
-    connect(m_treeViewLogic, &TreeViewLogic::addNoteToTag, m_listViewLogic, &ListViewLogic::onAddTagRequestD);
+    connect(m_treeViewLogic, &TreeViewLogic::addNotesToTag, m_listViewLogic, &ListViewLogic::onAddTagToNotesRequest);
     connect(m_listViewLogic, &ListViewLogic::listViewLabelChanged, this, [this](const QString &l1, const QString &l2) {
         m_ui->listviewLabel1->setText(l1);
         m_ui->listviewLabel2->setText(l2);
         m_splitter->setHandleWidth(0);
     });
+    m_startupSnapshotTimer.setSingleShot(true);
+    m_startupSnapshotTimer.setInterval(STARTUP_SNAPSHOT_IDLE_DELAY);
+    connect(&m_startupSnapshotTimer, &QTimer::timeout, this, [this] { saveStartupSnapshot(Qt::QueuedConnection); });
+    connect(m_dbManager, &DBManager::notesListReceived, &m_startupSnapshotTimer, qOverload<>(&QTimer::start), Qt::QueuedConnection);
+    connect(m_dbManager, &DBManager::childNotesCountUpdatedFolder, &m_startupSnapshotTimer, qOverload<>(&QTimer::start), Qt::QueuedConnection);
     connect(m_toggleTreeViewButton, &QPushButton::clicked, this, &MainWindow::toggleFolderTree);
     connect(m_dbManager, &DBManager::showErrorMessage, this, &MainWindow::showErrorMessage, Qt::QueuedConnection);
     connect(m_listViewLogic, &ListViewLogic::requestNewNote, this, &MainWindow::onNewNoteButtonClicked);
-    connect(m_listViewLogic, &ListViewLogic::moveNoteRequested, this, [this](int id, int target) {
-        m_treeViewLogic->onMoveNodeRequested(id, target);
+    connect(m_listViewLogic, &ListViewLogic::moveNotesRequested, this, [this](const QSet<int> &noteIds, int target) {
+        m_treeViewLogic->onMoveNotesRequested(noteIds, target);
         m_treeViewLogic->openFolder(target);
     });
     connect(m_listViewLogic, &ListViewLogic::setNewNoteButtonVisible, this, [this](bool visible) { m_ui->newNoteButton->setVisible(visible); });
-    connect(m_treeViewLogic, &TreeViewLogic::noteMoved, m_listViewLogic, &ListViewLogic::onNoteMovedOut);
+    connect(m_treeViewLogic, &TreeViewLogic::notesMoved, m_listViewLogic, &ListViewLogic::onNotesMovedOut);
 
     connect(m_listViewLogic, &ListViewLogic::requestClearSearchDb, this, &MainWindow::setNoteListLoading);
     connect(m_treeView, &NodeTreeView::loadNotesInTagsRequested, this, &MainWindow::setNoteListLoading);
@@ -934,17 +977,6 @@ void MainWindow::setupSubscrirptionWindow()
 {
     SubscriptionStatus::registerEnum("nuttyartist.notes", 1, 0);
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
-    const QUrl url("qrc:/qt/qml/SubscriptionWindow.qml");
-#else
-    const QUrl url("qrc:/qml/SubscriptionWindow.qml");
-#endif
-    m_subscriptionWindowEngine.rootContext()->setContextProperty("mainWindow", this);
-    m_subscriptionWindowEngine.load(url);
-    QObject *rootObject = m_subscriptionWindowEngine.rootObjects().first();
-    m_subscriptionWindow = qobject_cast<QWindow *>(rootObject);
-    m_subscriptionWindow->hide();
-
     connect(this, &MainWindow::proVersionCheck, this, [this]() {
         m_buyOrManageSubscriptionAction->setVisible(true);
         if (m_isProVersionActivated) {
@@ -957,6 +989,28 @@ void MainWindow::setupSubscrirptionWindow()
     verifyLicenseSignalsSlots();
 }
 
+/*!
+ * \brief MainWindow::createSubscriptionWindow
+ * Loads SubscriptionWindow.qml the first time the window is needed
+ */
+void MainWindow::createSubscriptionWindow()
+{
+    if (m_subscriptionWindow != nullptr) {
+        return;
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+    const QUrl url("qrc:/qt/qml/SubscriptionWindow.qml");
+#else
+    const QUrl url("qrc:/qml/SubscriptionWindow.qml");
+#endif
+    m_subscriptionWindowEngine.rootContext()->setContextProperty("mainWindow", this);
+    m_subscriptionWindowEngine.load(url);
+    QObject *rootObject = m_subscriptionWindowEngine.rootObjects().first();
+    m_subscriptionWindow = qobject_cast<QWindow *>(rootObject);
+    m_subscriptionWindow->hide();
+    sendCurrentStateToQml(rootObject);
+}
+
 void MainWindow::setupEditorSettings()
 {
     FontTypeface::registerEnum("nuttyartist.notes", 1, 0);
@@ -965,19 +1019,11 @@ void MainWindow::setupEditorSettings()
     Theme::registerEnum("nuttyartist.notes", 1, 0);
     View::registerEnum("nuttyartist.notes", 1, 0);
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
-    QUrl source("qrc:/qt/qml/EditorSettings.qml");
-#else
-    QUrl source("qrc:/qml/EditorSettings.qml");
-#endif
-
-    m_editorSettingsQuickView.rootContext()->setContextProperty("mainWindow", this);
-    m_editorSettingsQuickView.rootContext()->setContextProperty("noteEditorLogic", m_noteEditorLogic);
-    m_editorSettingsQuickView.setSource(source);
-    m_editorSettingsQuickView.setResizeMode(QQuickView::SizeViewToRootObject);
-    m_editorSettingsQuickView.setFlags(Qt::FramelessWindowHint);
-    m_editorSettingsQuickView.setColor(Qt::transparent);
-    m_editorSettingsWidget = QWidget::createWindowContainer(&m_editorSettingsQuickView, this);
+    // The QML view is only loaded into this popup the first time it's shown,
+    // see createEditorSettingsView()
+    auto *layout = new QVBoxLayout(m_editorSettingsWidget);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(0);
 #if defined(Q_OS_MACOS)
 #  if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
     m_editorSettingsWidget->setWindowFlags(Qt::Popup | Qt::FramelessWindowHint | Qt::NoDropShadowWindowHint);
@@ -997,24 +1043,84 @@ void MainWindow::setupEditorSettings()
     m_editorSettingsWidget->setAttribute(Qt::WA_TranslucentBackground);
     m_editorSettingsWidget->hide();
     m_editorSettingsWidget->installEventFilter(this);
+}
+
+/*!
+ * \brief MainWindow::createEditorSettingsView
+ * Loads EditorSettings.qml into the Editor Settings popup on first use
+ */
+void MainWindow::createEditorSettingsView()
+{
+    if (m_editorSettingsQuickView.source().isValid()) {
+        return;
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+    QUrl source("qrc:/qt/qml/EditorSettings.qml");
+#else
+    QUrl source("qrc:/qml/EditorSettings.qml");
+#endif
+
+    m_editorSettingsQuickView.rootContext()->setContextProperty("mainWindow", this);
+    m_editorSettingsQuickView.rootContext()->setContextProperty("noteEditorLogic", m_noteEditorLogic);
+    m_editorSettingsQuickView.setSource(source);
+    m_editorSettingsQuickView.setResizeMode(QQuickView::SizeViewToRootObject);
+    m_editorSettingsQuickView.setFlags(Qt::FramelessWindowHint);
+    m_editorSettingsQuickView.setColor(Qt::transparent);
+    m_editorSettingsWidget->layout()->addWidget(QWidget::createWindowContainer(&m_editorSettingsQuickView, m_editorSettingsWidget));
+    sendCurrentStateToQml(m_editorSettingsQuickView.rootObject());
+}
 
-    QJsonObject dataToSendToView{ { "displayFont",
-                                    QFont(QStringLiteral("SF Pro Text")).exactMatch() ? QStringLiteral("SF Pro Text") : QStringLiteral("Roboto") } };
-    emit displayFontSet(QVariant(dataToSendToView));
+/*!
+ * \brief MainWindow::sendCurrentStateToQml
+ * The QML views are created lazily, so they miss the signals emitted while
+ * the window was set up. Hand the current state to the handlers of the
+ * freshly loaded view only, re-emitting the signals would also re-run every
+ * other view and slot already connected to them.
+ */
+void MainWindow::sendCurrentStateToQml(QObject *rootObject)
+{
+    QObject *connections = rootObject != nullptr ? rootObject->findChild<QObject *>(QStringLiteral("mainWindowConnections")) : nullptr;
+    auto *window = qobject_cast<QQuickWindow *>(rootObject);
+    if (connections == nullptr && window != nullptr) {
+        // objects declared in a Window are parented to its content item
+        connections = window->contentItem()->findChild<QObject *>(QStringLiteral("mainWindowConnections"));
+    }
+    if (connections == nullptr) {
+        qDebug() << __FUNCTION__ << __LINE__ << "No mainWindow connections in the QML view";
+        return;
+    }
+    auto send = [connections](const char *handler, const QVariant &data) {
+        // a view only declares the handlers it cares about
+        if (connections->metaObject()->indexOfMethod(QByteArray(handler).append("(QVariant)")) == -1) {
+            return;
+        }
+        QMetaObject::invokeMethod(connections, handler, Q_ARG(QVariant, data));
+    };
 
 #if defined(Q_OS_WINDOWS)
-    emit platformSet(QVariant(QStringLiteral("Windows")));
+    send("onPlatformSet", QVariant(QStringLiteral("Windows")));
 #elif defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
-    emit platformSet(QVariant(QStringLiteral("Unix")));
+    send("onPlatformSet", QVariant(QStringLiteral("Unix")));
 #elif defined(Q_OS_MACOS)
-    emit platformSet(QVariant(QStringLiteral("Apple")));
+    send("onPlatformSet", QVariant(QStringLiteral("Apple")));
 #endif
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
-    emit qtVersionSet(QVariant(6));
+    send("onQtVersionSet", QVariant(6));
 #else
-    emit qtVersionSet(QVariant(5));
+    send("onQtVersionSet", QVariant(5));
 #endif
+
+    QJsonObject displayFontData{ { "displayFont",
+                                   QFont(QStringLiteral("SF Pro Text")).exactMatch() ? QStringLiteral("SF Pro Text") : QStringLiteral("Roboto") } };
+    send("onDisplayFontSet", QVariant(displayFontData));
+    send("onThemeChanged", QVariant(qmlThemeData(m_currentTheme)));
+    send("onFontsChanged", QVariant(qmlFontsData()));
+    send("onMainWindowResized", QVariant(QJsonObject{ { "parentWindowHeight", height() }, { "parentWindowWidth", width() } }));
+    send("onMainWindowMoved", QVariant(QJsonObject{ { "parentWindowX", x() }, { "parentWindowY", y() } }));
+    send("onProVersionCheck", QVariant(m_isProVersionActivated));
+    send("onSubscriptionStatusChanged", QVariant(m_subscriptionStatus));
+    send("onSettingsChanged", QVariant(selectedOptionsEditorSettingsData()));
 }
 
 /*!
@@ -1062,6 +1168,15 @@ void MainWindow::setCurrentFontBasedOnTypeface(FontTypeface::Value selectedFontT
 
     alignTextEditText();
 
+    emit fontsChanged(QVariant(qmlFontsData()));
+}
+
+/*!
+ * \brief MainWindow::qmlFontsData
+ * The font lists and current choices as sent to the QML views
+ */
+QJsonObject MainWindow::qmlFontsData() const
+{
     QJsonObject dataToSendToView;
     dataToSendToView["listOfSansSerifFonts"] = QJsonArray::fromStringList(m_listOfSansSerifFonts);
     dataToSendToView["listOfSerifFonts"] = QJsonArray::fromStringList(m_listOfSerifFonts);
@@ -1070,7 +1185,7 @@ void MainWindow::setCurrentFontBasedOnTypeface(FontTypeface::Value selectedFontT
     dataToSendToView["chosenSerifFontIndex"] = m_chosenSerifFontIndex;
     dataToSendToView["chosenMonoFontIndex"] = m_chosenMonoFontIndex;
     dataToSendToView["currentFontTypeface"] = to_string(m_currentFontTypeface).c_str();
-    emit fontsChanged(QVariant(dataToSendToView));
+    return dataToSendToView;
 }
 
 /*!
@@ -1204,26 +1319,32 @@ void MainWindow::setupKanbanView()
     // Source:
     // https://doc.qt.io/qt-6/qtquick-quickwidgets-qquickwidgetversuswindow-opengl-example.html
 
+    m_kanbanWidget = new QWidget(this);
+    auto *layout = new QVBoxLayout(m_kanbanWidget);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(0);
+    m_kanbanWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+    m_kanbanWidget->hide();
+    m_ui->verticalLayout_textEdit->insertWidget(m_ui->verticalLayout_textEdit->indexOf(m_textEdit), m_kanbanWidget);
+}
+
+/*!
+ * \brief MainWindow::createKanbanView
+ * Loads kanbanMain.qml into m_kanbanWidget the first time the kanban is shown
+ */
+void MainWindow::createKanbanView()
+{
+    if (m_kanbanQuickView.source().isValid()) {
+        return;
+    }
     QUrl source("qrc:/qt/qml/kanbanMain.qml");
     m_kanbanQuickView.rootContext()->setContextProperty("noteEditorLogic", m_noteEditorLogic);
+    m_kanbanQuickView.rootContext()->setContextProperty("kanbanColumnModel", m_noteEditorLogic->kanbanColumnModel());
     m_kanbanQuickView.rootContext()->setContextProperty("mainWindow", this);
     m_kanbanQuickView.setSource(source);
     m_kanbanQuickView.setResizeMode(QQuickView::SizeRootObjectToView);
-    m_kanbanWidget = QWidget::createWindowContainer(&m_kanbanQuickView, this);
-    m_kanbanWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_kanbanWidget->hide();
-    m_ui->verticalLayout_textEdit->insertWidget(m_ui->verticalLayout_textEdit->indexOf(m_textEdit), m_kanbanWidget);
-#  if defined(Q_OS_WINDOWS)
-    emit platformSet(QVariant(QStringLiteral("Windows")));
-#  elif defined(Q_OS_UNIX) && !defined(Q_OS_MACOS)
-    emit platformSet(QVariant(QStringLiteral("Unix")));
-#  elif defined(Q_OS_MACOS)
-    emit platformSet(QVariant(QStringLiteral("Apple")));
-#  endif
-
-    QJsonObject dataToSendToView{ { "displayFont",
-                                    QFont(QStringLiteral("SF Pro Text")).exactMatch() ? QStringLiteral("SF Pro Text") : QStringLiteral("Roboto") } };
-    emit displayFontSet(QVariant(dataToSendToView));
+    m_kanbanWidget->layout()->addWidget(QWidget::createWindowContainer(&m_kanbanQuickView, m_kanbanWidget));
+    sendCurrentStateToQml(m_kanbanQuickView.rootObject());
 }
 #endif
 
@@ -1409,8 +1530,10 @@ void MainWindow::getSubscriptionStatus()
         qDebug() << "m_subscriptionStatus: " << m_subscriptionStatus;
         emit subscriptionStatusChanged(QVariant(m_subscriptionStatus));
 
-        if (!m_isProVersionActivated && showSubscriptionWindowWhenNotPro)
+        if (!m_isProVersionActivated && showSubscriptionWindowWhenNotPro) {
+            createSubscriptionWindow();
             m_subscriptionWindow->show();
+        }
     });
 }
 
@@ -1503,6 +1626,7 @@ QVariant MainWindow::getUserLicenseKey()
 
 void MainWindow::openSubscriptionWindow()
 {
+    createSubscriptionWindow();
     m_subscriptionWindow->show();
 }
 
@@ -1593,6 +1717,11 @@ void MainWindow::setupDatabases()
     if (needMigrateFromV1_5_0) {
         m_settingsDatabase->setValue(QStringLiteral("version"), qApp->applicationVersion());
     }
+    m_startupSnapshotPath = dir.path() + QDir::separator() + QStringLiteral("startup_snapshot.bin");
+    m_startupSnapshotDbPath = QFileInfo(noteDBFilePath).absoluteFilePath();
+    if (doCreate) {
+        QFile::remove(m_startupSnapshotPath);
+    }
     m_dbManager = new DBManager;
     m_dbThread = new QThread;
     m_dbThread->setObjectName(QStringLiteral("dbThread"));
@@ -1605,6 +1734,7 @@ void MainWindow::setupDatabases()
         }
     });
     connect(this, &MainWindow::requestOpenDBManager, m_dbManager, &DBManager::onOpenDBManagerRequested, Qt::QueuedConnection);
+    connect(m_dbManager, &DBManager::databaseOpened, this, &MainWindow::initData, Qt::QueuedConnection);
     connect(this, &MainWindow::requestMigrateNotesFromV1_5_0, m_dbManager, &DBManager::onMigrateNotesFrom1_5_0Requested, Qt::QueuedConnection);
     connect(m_dbThread, &QThread::finished, m_dbManager, &QObject::deleteLater);
     m_dbThread->start();
@@ -1626,11 +1756,53 @@ void MainWindow::setupModelView()
     m_treeViewLogic = new TreeViewLogic(m_treeView, m_treeModel, m_dbManager, m_listView, this);
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
     m_noteEditorLogic = new NoteEditorLogic(m_textEdit, m_editorDateLabel, m_searchEdit, m_kanbanWidget, m_ui->tagListView, m_tagPool, m_dbManager, this);
-    m_kanbanQuickView.rootContext()->setContextProperty("noteEditorLogic", m_noteEditorLogic);
 #else
     m_noteEditorLogic = new NoteEditorLogic(m_textEdit, m_editorDateLabel, m_searchEdit, m_ui->tagListView, m_tagPool, m_dbManager, this);
 #endif
-    m_editorSettingsQuickView.rootContext()->setContextProperty("noteEditorLogic", m_noteEditorLogic);
+}
+
+/*!
+ * \brief MainWindow::loadStartupSnapshot
+ * Paints the tree and the last viewed list page from the snapshot written on
+ * the previous run, so the window is populated before the database is open.
+ * initData still requests the real data, which replaces the snapshot.
+ * A snapshot taken from another database, e.g. before the database path was
+ * changed, is discarded.
+ */
+void MainWindow::loadStartupSnapshot()
+{
+    StartupSnapshot snapshot;
+    if (!snapshot.read(m_startupSnapshotPath)) {
+        return;
+    }
+    if (snapshot.dbPath != m_startupSnapshotDbPath) {
+        QFile::remove(m_startupSnapshotPath);
+        return;
+    }
+    m_tagPool->setTagList(snapshot.treeData.tagTreeData);
+    m_treeViewLogic->loadTreeSnapshot(snapshot.treeData, snapshot.allNotesCount, snapshot.trashCount);
+    m_listViewLogic->loadNoteListSnapshot(snapshot.notes, snapshot.listViewInfo(), snapshot.listLabel1, snapshot.listLabel2);
+}
+
+/*!
+ * \brief MainWindow::saveStartupSnapshot
+ * Hands the first page of the note list to DBManager, which adds the tree
+ * and writes the snapshot file for the next launch.
+ */
+void MainWindow::saveStartupSnapshot(Qt::ConnectionType connectionType)
+{
+    if (m_startupSnapshotPath.isEmpty()) {
+        return;
+    }
+    QVector<NodeData> notes;
+    const int count = std::min(m_listModel->rowCount(), STARTUP_SNAPSHOT_NOTE_COUNT);
+    notes.reserve(count);
+    for (int row = 0; row < count; ++row) {
+        notes.append(m_listModel->getNote(m_listModel->index(row, 0)));
+    }
+    QMetaObject::invokeMethod(m_dbManager, "onSaveStartupSnapshotRequested", connectionType, Q_ARG(QString, m_startupSnapshotPath),
+                              Q_ARG(QVector<NodeData>, notes), Q_ARG(ListViewInfo, m_listViewLogic->listViewInfo()),
+                              Q_ARG(QString, m_ui->listviewLabel1->text()), Q_ARG(QString, m_ui->listviewLabel2->text()));
 }
 
 /*!
@@ -1820,6 +1992,9 @@ void MainWindow::setKanbanVisibility(bool isVisible)
 {
     auto inf = m_listViewLogic->listViewInfo();
     if (isVisible && inf.parentFolderId != TRASH_FOLDER_ID) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+        createKanbanView();
+#endif
         emit m_noteEditorLogic->showKanbanView();
     } else {
         emit m_noteEditorLogic->hideKanbanView();
@@ -2114,6 +2289,7 @@ void MainWindow::onGlobalSettingsButtonClicked()
  */
 void MainWindow::showEditorSettings()
 {
+    createEditorSettingsView();
     resizeAndPositionEditorSettingsWindow();
     QJsonObject dataToSendToView;
     dataToSendToView["parentWindowHeight"] = this->height();
@@ -2143,6 +2319,11 @@ void MainWindow::toggleEditorSettings()
  * \brief MainWindow::updateSelectedOptionsEditorSettings
  */
 void MainWindow::updateSelectedOptionsEditorSettings()
+{
+    emit settingsChanged(QVariant(selectedOptionsEditorSettingsData()));
+}
+
+QJsonObject MainWindow::selectedOptionsEditorSettingsData() const
 {
     QJsonObject dataToSendToView;
     dataToSendToView["currentFontTypeface"] = to_string(m_currentFontTypeface).c_str();
@@ -2155,7 +2336,7 @@ void MainWindow::updateSelectedOptionsEditorSettings()
     dataToSendToView["isFoldersTreeCollapsed"] = m_foldersWidget->isHidden();
     dataToSendToView["isMarkdownDisabled"] = !m_noteEditorLogic->markdownEnabled();
     dataToSendToView["isStayOnTop"] = m_alwaysStayOnTop;
-    emit settingsChanged(QVariant(dataToSendToView));
+    return dataToSendToView;
 }
 
 /*!
@@ -2277,11 +2458,10 @@ void MainWindow::setTheme(Theme::Value theme)
     setCSSThemeAndUpdate(m_ui->frameLeft, m_currentTheme);
     setCSSThemeAndUpdate(m_ui->frameRight, m_currentTheme);
     setCSSThemeAndUpdate(m_ui->frameRightTop, m_currentTheme);
+    emit themeChanged(QVariant(qmlThemeData(theme)));
 
     switch (theme) {
     case Theme::Light: {
-        QJsonObject themeData{ { "theme", QStringLiteral("Light") }, { "backgroundColor", "#f7f7f7" } };
-        emit themeChanged(QVariant(themeData));
         m_currentEditorTextColor = QColor(26, 26, 26);
         m_searchButton->setStyleSheet("QToolButton { color: rgb(205, 205, 205) }");
         m_clearButton->setStyleSheet("QToolButton { color: rgb(114, 114, 114) }");
@@ -2289,8 +2469,6 @@ void MainWindow::setTheme(Theme::Value theme)
         break;
     }
     case Theme::Dark: {
-        QJsonObject themeData{ { "theme", QStringLiteral("Dark") }, { "backgroundColor", "#191919" } };
-        emit themeChanged(QVariant(themeData));
         m_currentEditorTextColor = QColor(212, 212, 212);
         m_searchButton->setStyleSheet("QToolButton { color: rgb(68, 68, 68) }");
         m_clearButton->setStyleSheet("QToolButton { color: rgb(147, 144, 147) }");
@@ -2298,8 +2476,6 @@ void MainWindow::setTheme(Theme::Value theme)
         break;
     }
     case Theme::Sepia: {
-        QJsonObject themeData{ { "theme", QStringLiteral("Sepia") }, { "backgroundColor", "#fbf0d9" } };
-        emit themeChanged(QVariant(themeData));
         m_currentEditorTextColor = QColor(50, 30, 3);
         m_searchButton->setStyleSheet("QToolButton { color: rgb(205, 205, 205) }");
         m_clearButton->setStyleSheet("QToolButton { color: rgb(114, 114, 114) }");
@@ -2354,6 +2530,7 @@ void MainWindow::createNewNote()
         tmpNote.setCreationDateTime(noteDate);
         tmpNote.setLastModificationDateTime(noteDate);
         tmpNote.setFullTitle(QStringLiteral("New Note"));
+        tmpNote.setPreview(NodeData::getSecondLine(tmpNote.content()));
         auto inf = m_listViewLogic->listViewInfo();
         if ((!inf.isInTag) && (inf.parentFolderId > ROOT_FOLDER_ID)) {
             NodeData parent;
@@ -2564,6 +2741,8 @@ void MainWindow::quitApplication()
     }
 
     m_noteEditorLogic->saveNoteToDB();
+    m_startupSnapshotTimer.stop();
+    saveStartupSnapshot(Qt::BlockingQueuedConnection);
 
 #if defined(UPDATE_CHECKER)
     m_settingsDatabase->setValue(QStringLiteral("dontShowUpdateWindow"), m_dontShowUpdateWindow);
@@ -3347,7 +3526,7 @@ void MainWindow::migrateNoteFromV0_9_0(const QString &notePath)
         newNote.setLastModificationDateTime(QDateTime::fromString(lastEditedDateDB, Qt::ISODate));
         QString contentText = notesIni.value(noteName + QStringLiteral("/content"), "Error").toString();
         newNote.setContent(contentText);
-        QString firstLine = NoteEditorLogic::getFirstLine(contentText);
+        QString firstLine = NodeData::getFirstLine(contentText);
         newNote.setFullTitle(firstLine);
         noteList.append(newNote);
     }
@@ -3383,7 +3562,7 @@ void MainWindow::migrateTrashFromV0_9_0(const QString &trashPath)
         newNote.setLastModificationDateTime(QDateTime::fromString(lastEditedDateDB, Qt::ISODate));
         QString contentText = trashIni.value(noteName + QStringLiteral("/content"), "Error").toString();
         newNote.setContent(contentText);
-        QString firstLine = NoteEditorLogic::getFirstLine(contentText);
+        QString firstLine = NodeData::getFirstLine(contentText);
         newNote.setFullTitle(firstLine);
         noteList.append(newNote);
     }
@@ -253,6 +253,9 @@ private:
     QAction *m_buyOrManageSubscriptionAction;
     QAction *m_hideToTrayAction;
     QTimer m_checkUpdatesTimer;
+    QString m_startupSnapshotPath;
+    QString m_startupSnapshotDbPath;
+    QTimer m_startupSnapshotTimer;
 
     bool alreadyAppliedFormat(const QString &formatChars);
     void applyFormat(const QString &formatChars);
@@ -268,12 +271,18 @@ private:
 #endif
     void setupSearchEdit();
     void setupSubscrirptionWindow();
+    void createSubscriptionWindow();
     void setupEditorSettings();
+    void createEditorSettingsView();
+    void sendCurrentStateToQml(QObject *rootObject);
+    QJsonObject qmlFontsData() const;
+    QJsonObject selectedOptionsEditorSettingsData() const;
     void setupTextEditStyleSheet(int paddingLeft, int paddingRight);
     void alignTextEditText();
     void setupTextEdit();
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
     void setupKanbanView();
+    void createKanbanView();
 #endif
     void setupDatabases();
     void setupModelView();
@@ -283,6 +292,8 @@ private:
     void setButtonsAndFieldsEnabled(bool doEnable);
     void resetFormat(const QString &formatChars);
     void restoreStates();
+    void loadStartupSnapshot();
+    void saveStartupSnapshot(Qt::ConnectionType connectionType);
     void migrateFromV0_9_0();
     void executeImport(bool replace);
     void migrateNoteFromV0_9_0(const QString &notePath);
@@ -1,220 +1,451 @@
 #include "nodedata.h"
+#include <QCoreApplication>
 #include <QDataStream>
+#include <QTextDocument>
+#include <QTextStream>
+#include <algorithm>
 
-NodeData::NodeData()
-    : m_id{ INVALID_NODE_ID },
-      m_isModified(false),
-      m_isSelected(false),
-      m_scrollBarPosition(0),
-      m_nodeType(Type::Note),
-      m_parentId(INVALID_NODE_ID),
-      m_relativePosition(0),
-      m_isTempNote{ false },
-      m_isPinnedNote{ false },
-      m_tagListScrollBarPos{ 0 },
-      m_relativePosAN{ 0 },
-      m_childNotesCount{ 0 }
+#define FIRST_LINE_MAX 80
+
+static QDateTime toDateTime(qint64 msecsSinceEpoch)
+{
+    if (msecsSinceEpoch == INVALID_TIME) {
+        return QDateTime();
+    }
+    return QDateTime::fromMSecsSinceEpoch(msecsSinceEpoch);
+}
+
+static qint64 toTime(const QDateTime &dateTime)
+{
+    if (!dateTime.isValid()) {
+        return INVALID_TIME;
+    }
+    return dateTime.toMSecsSinceEpoch();
+}
+
+class NodeDataPrivate : public QSharedData
+{
+public:
+    int m_id{ INVALID_NODE_ID };
+    QString m_fullTitle;
+    qint64 m_lastModificationTime{ INVALID_TIME };
+    qint64 m_creationTime{ INVALID_TIME };
+    qint64 m_deletionTime{ INVALID_TIME };
+    QString m_content;
+    bool m_isModified{ false };
+    bool m_isSelected{ false };
+    int m_scrollBarPosition{ 0 };
+    NodeData::Type m_nodeType{ NodeData::Type::Note };
+    int m_parentId{ INVALID_NODE_ID };
+    int m_relativePosition{ 0 };
+    QString m_absolutePath;
+    TagIdList m_tagIds; // kept sorted
+    bool m_isTempNote{ false };
+    QString m_parentName;
+    bool m_isPinnedNote{ false };
+    int m_tagListScrollBarPos{ 0 };
+    int m_relativePosAN{ 0 };
+    int m_childNotesCount{ 0 };
+    QString m_displayTitle;
+    QString m_preview;
+    bool m_isContentLoaded{ true };
+};
+
+NodeData::NodeData() : d{ new NodeDataPrivate }
 {
 }
 
+NodeData::NodeData(const NodeData &other) = default;
+
+NodeData::NodeData(NodeData &&other) noexcept = default;
+
+NodeData &NodeData::operator=(const NodeData &other) = default;
+
+NodeData &NodeData::operator=(NodeData &&other) noexcept = default;
+
+NodeData::~NodeData() = default;
+
 int NodeData::id() const
 {
-    return m_id;
+    return d->m_id;
 }
 
 void NodeData::setId(int id)
 {
-    m_id = id;
+    d->m_id = id;
 }
 
 QString const &NodeData::fullTitle() const
 {
-    return m_fullTitle;
+    return d->m_fullTitle;
 }
 
 void NodeData::setFullTitle(const QString &fullTitle)
 {
-    m_fullTitle = fullTitle;
+    d->m_fullTitle = fullTitle;
 }
 
-QDateTime const &NodeData::lastModificationdateTime() const
+QDateTime NodeData::lastModificationdateTime() const
 {
-    return m_lastModificationDateTime;
+    return toDateTime(d->m_lastModificationTime);
 }
 
 void NodeData::setLastModificationDateTime(const QDateTime &lastModificationdateTime)
 {
-    m_lastModificationDateTime = lastModificationdateTime;
+    d->m_lastModificationTime = toTime(lastModificationdateTime);
+}
+
+qint64 NodeData::lastModificationTime() const
+{
+    return d->m_lastModificationTime;
+}
+
+void NodeData::setLastModificationTime(qint64 msecsSinceEpoch)
+{
+    d->m_lastModificationTime = msecsSinceEpoch;
 }
 
 QString const &NodeData::content() const
 {
-    return m_content;
+    return d->m_content;
 }
 
 void NodeData::setContent(const QString &content)
 {
-    m_content = content;
+    d->m_content = content;
 }
 
 bool NodeData::isModified() const
 {
-    return m_isModified;
+    return d->m_isModified;
 }
 
 void NodeData::setModified(bool isModified)
 {
-    m_isModified = isModified;
+    d->m_isModified = isModified;
 }
 
 bool NodeData::isSelected() const
 {
-    return m_isSelected;
+    return d->m_isSelected;
 }
 
 void NodeData::setSelected(bool isSelected)
 {
-    m_isSelected = isSelected;
+    d->m_isSelected = isSelected;
 }
 
 int NodeData::scrollBarPosition() const
 {
-    return m_scrollBarPosition;
+    return d->m_scrollBarPosition;
 }
 
 void NodeData::setScrollBarPosition(int scrollBarPosition)
 {
-    m_scrollBarPosition = scrollBarPosition;
+    d->m_scrollBarPosition = scrollBarPosition;
 }
 
 QDateTime NodeData::deletionDateTime() const
 {
-    return m_deletionDateTime;
+    return toDateTime(d->m_deletionTime);
 }
 
 void NodeData::setDeletionDateTime(const QDateTime &deletionDateTime)
 {
-    m_deletionDateTime = deletionDateTime;
+    d->m_deletionTime = toTime(deletionDateTime);
+}
+
+qint64 NodeData::deletionTime() const
+{
+    return d->m_deletionTime;
+}
+
+void NodeData::setDeletionTime(qint64 msecsSinceEpoch)
+{
+    d->m_deletionTime = msecsSinceEpoch;
 }
 
 NodeData::Type NodeData::nodeType() const
 {
-    return m_nodeType;
+    return d->m_nodeType;
 }
 
 void NodeData::setNodeType(NodeData::Type newNodeType)
 {
-    m_nodeType = newNodeType;
+    d->m_nodeType = newNodeType;
 }
 
 int NodeData::parentId() const
 {
-    return m_parentId;
+    return d->m_parentId;
 }
 
 void NodeData::setParentId(int newParentId)
 {
-    m_parentId = newParentId;
+    d->m_parentId = newParentId;
 }
 
 int NodeData::relativePosition() const
 {
-    return m_relativePosition;
+    return d->m_relativePosition;
 }
 
 void NodeData::setRelativePosition(int newRelativePosition)
 {
-    m_relativePosition = newRelativePosition;
+    d->m_relativePosition = newRelativePosition;
 }
 
 const QString &NodeData::absolutePath() const
 {
-    return m_absolutePath;
+    return d->m_absolutePath;
 }
 
 void NodeData::setAbsolutePath(const QString &newAbsolutePath)
 {
-    m_absolutePath = newAbsolutePath;
+    d->m_absolutePath = newAbsolutePath;
 }
 
-const QSet<int> &NodeData::tagIds() const
+QSet<int> NodeData::tagIds() const
 {
-    return m_tagIds;
+    return QSet<int>(d->m_tagIds.cbegin(), d->m_tagIds.cend());
 }
 
 void NodeData::setTagIds(const QSet<int> &newTagIds)
 {
-    m_tagIds = newTagIds;
+    d->m_tagIds.clear();
+    d->m_tagIds.reserve(newTagIds.size());
+    for (const auto tagId : newTagIds) {
+        d->m_tagIds.append(tagId);
+    }
+    std::sort(d->m_tagIds.begin(), d->m_tagIds.end());
+}
+
+const TagIdList &NodeData::tagIdList() const
+{
+    return d->m_tagIds;
+}
+
+void NodeData::setTagIdList(const TagIdList &newTagIds)
+{
+    d->m_tagIds = newTagIds;
+    std::sort(d->m_tagIds.begin(), d->m_tagIds.end());
+}
+
+bool NodeData::hasTags() const
+{
+    return !d->m_tagIds.isEmpty();
+}
+
+bool NodeData::hasTag(int tagId) const
+{
+    return std::binary_search(d->m_tagIds.cbegin(), d->m_tagIds.cend(), tagId);
 }
 
 bool NodeData::isTempNote() const
 {
-    return m_isTempNote;
+    return d->m_isTempNote;
 }
 
 void NodeData::setIsTempNote(bool newIsTempNote)
 {
-    m_isTempNote = newIsTempNote;
+    d->m_isTempNote = newIsTempNote;
 }
 
 const QString &NodeData::parentName() const
 {
-    return m_parentName;
+    return d->m_parentName;
 }
 
 void NodeData::setParentName(const QString &newParentName)
 {
-    m_parentName = newParentName;
+    d->m_parentName = newParentName;
 }
 
 bool NodeData::isPinnedNote() const
 {
-    return m_isPinnedNote;
+    return d->m_isPinnedNote;
 }
 
 void NodeData::setIsPinnedNote(bool newIsPinnedNote)
 {
-    m_isPinnedNote = newIsPinnedNote;
+    d->m_isPinnedNote = newIsPinnedNote;
 }
 
 int NodeData::tagListScrollBarPos() const
 {
-    return m_tagListScrollBarPos;
+    return d->m_tagListScrollBarPos;
 }
 
 void NodeData::setTagListScrollBarPos(int newTagListScrollBarPos)
 {
-    m_tagListScrollBarPos = newTagListScrollBarPos;
+    d->m_tagListScrollBarPos = newTagListScrollBarPos;
 }
 
 int NodeData::relativePosAN() const
 {
-    return m_relativePosAN;
+    return d->m_relativePosAN;
 }
 
 void NodeData::setRelativePosAN(int newRelativePosAN)
 {
-    m_relativePosAN = newRelativePosAN;
+    d->m_relativePosAN = newRelativePosAN;
 }
 
 int NodeData::childNotesCount() const
 {
-    return m_childNotesCount;
+    return d->m_childNotesCount;
 }
 
 void NodeData::setChildNotesCount(int newChildCount)
 {
-    m_childNotesCount = newChildCount;
+    d->m_childNotesCount = newChildCount;
+}
+
+const QString &NodeData::displayTitle() const
+{
+    return d->m_displayTitle;
+}
+
+void NodeData::setDisplayTitle(const QString &newDisplayTitle)
+{
+    d->m_displayTitle = newDisplayTitle;
+}
+
+const QString &NodeData::preview() const
+{
+    return d->m_preview;
+}
+
+void NodeData::setPreview(const QString &newPreview)
+{
+    d->m_preview = newPreview;
+}
+
+bool NodeData::isContentLoaded() const
+{
+    return d->m_isContentLoaded;
+}
+
+void NodeData::setIsContentLoaded(bool newIsContentLoaded)
+{
+    d->m_isContentLoaded = newIsContentLoaded;
+}
+
+/*!
+ * \brief NodeData::getNthLine
+ * Returns the display text of the first non-empty line at or after
+ * targetLineNumber in str. Pure string work, so the database thread can
+ * compute previews with it
+ * \param str
+ * \param targetLineNumber
+ * \return
+ */
+QString NodeData::getNthLine(const QString &str, int targetLineNumber)
+{
+    if (targetLineNumber < 1) {
+        return QCoreApplication::translate("NoteEditorLogic", "Invalid line number");
+    }
+
+    int previousLineBreakIndex = -1;
+    int lineCount = 0;
+    for (int i = 0; i <= str.length(); i++) {
+        if (i == str.length() || str[i] == '\n') {
+            lineCount++;
+            if (lineCount >= targetLineNumber && (i - previousLineBreakIndex > 1 || (i > 0 && i == str.length() && str[i - 1] != '\n'))) {
+                QString text;
+                if (getLineDisplayText(str.mid(previousLineBreakIndex + 1, i - previousLineBreakIndex - 1), text)) {
+                    return text;
+                }
+            }
+            previousLineBreakIndex = i;
+        }
+    }
+
+    return QCoreApplication::translate("NoteEditorLogic", "No additional text");
+}
+
+/*!
+ * \brief NodeData::getLineDisplayText
+ * Renders one markdown line to the plain text shown in the note list.
+ * Returns false for lines that are never shown, like rules and fences
+ * \param line
+ * \param text
+ * \return
+ */
+bool NodeData::getLineDisplayText(const QString &line, QString &text)
+{
+    auto trimmedLine = line.trimmed();
+    if (trimmedLine.isEmpty() || trimmedLine.startsWith("---") || trimmedLine.startsWith("```")) {
+        return false;
+    }
+    QTextDocument doc;
+    doc.setMarkdown(trimmedLine);
+    text = doc.toPlainText();
+    if (text.length() > 1 && text.at(0) == '^') {
+        text = text.mid(1);
+    }
+    if (text.isEmpty()) {
+        text = QCoreApplication::translate("NoteEditorLogic", "No additional text");
+        return true;
+    }
+    QTextStream ts(&text);
+    text = ts.readLine(FIRST_LINE_MAX);
+    return true;
+}
+
+/*!
+ * \brief NodeData::getFirstLine
+ * Get a string 'str' and return only the first line of it
+ * If the string contain no text, return "New Note"
+ * TODO: We might make it more efficient by not loading the entire string into the memory
+ * \param str
+ * \return
+ */
+QString NodeData::getFirstLine(const QString &str)
+{
+    return getNthLine(str, 1);
+}
+
+QString NodeData::getSecondLine(const QString &str)
+{
+    return getNthLine(str, 2);
+}
+
+/*!
+ * \brief NodeData::getDisplayTitle
+ * Normalize a stored title for the note list: trim it and drop a leading
+ * markdown heading mark
+ * \param fullTitle
+ * \return
+ */
+QString NodeData::getDisplayTitle(const QString &fullTitle)
+{
+    auto text = fullTitle.trimmed();
+    if (text.startsWith("#")) {
+        text.remove(0, 1);
+        text = text.trimmed();
+    }
+    return text;
 }
 
 QDateTime NodeData::creationDateTime() const
 {
-    return m_creationDateTime;
+    return toDateTime(d->m_creationTime);
 }
 
 void NodeData::setCreationDateTime(const QDateTime &creationDateTime)
 {
-    m_creationDateTime = creationDateTime;
+    d->m_creationTime = toTime(creationDateTime);
+}
+
+qint64 NodeData::creationTime() const
+{
+    return d->m_creationTime;
+}
+
+void NodeData::setCreationTime(qint64 msecsSinceEpoch)
+{
+    d->m_creationTime = msecsSinceEpoch;
 }
 
 QDataStream &operator>>(QDataStream &stream, NodeData &nodeData)
@@ -4,18 +4,37 @@
 #include <QObject>
 #include <QDateTime>
 #include <QSet>
+#include <QVarLengthArray>
+#include <limits>
+#include <QSharedDataPointer>
 
 namespace {
 auto constexpr INVALID_NODE_ID = -1;
 auto constexpr ROOT_FOLDER_ID = 0;
 auto constexpr TRASH_FOLDER_ID = 1;
 auto constexpr DEFAULT_NOTES_FOLDER_ID = 2;
+auto constexpr INVALID_TIME = std::numeric_limits<qint64>::min();
 } // namespace
 
+using TagIdList = QVarLengthArray<int, 4>;
+
+class NodeDataPrivate;
+
+/*!
+ * \brief The NodeData class
+ * Implicitly shared: copies made when passing notes through queued signals or
+ * into the list model only bump a reference count, the payload is detached on
+ * the first setter call
+ */
 class NodeData
 {
 public:
     explicit NodeData();
+    NodeData(const NodeData &other);
+    NodeData(NodeData &&other) noexcept;
+    NodeData &operator=(const NodeData &other);
+    NodeData &operator=(NodeData &&other) noexcept;
+    ~NodeData();
 
     enum class Type : uint8_t { Note = 0, Folder };
 
@@ -25,11 +44,15 @@ public:
     QString const &fullTitle() const;
     void setFullTitle(const QString &fullTitle);
 
-    QDateTime const &lastModificationdateTime() const;
+    QDateTime lastModificationdateTime() const;
     void setLastModificationDateTime(const QDateTime &lastModificationdateTime);
+    qint64 lastModificationTime() const;
+    void setLastModificationTime(qint64 msecsSinceEpoch);
 
     QDateTime creationDateTime() const;
     void setCreationDateTime(const QDateTime &creationDateTime);
+    qint64 creationTime() const;
+    void setCreationTime(qint64 msecsSinceEpoch);
 
     QString const &content() const;
     void setContent(const QString &content);
@@ -45,6 +68,8 @@ public:
 
     QDateTime deletionDateTime() const;
     void setDeletionDateTime(const QDateTime &deletionDateTime);
+    qint64 deletionTime() const;
+    void setDeletionTime(qint64 msecsSinceEpoch);
 
     NodeData::Type nodeType() const;
     void setNodeType(NodeData::Type newNodeType);
@@ -58,8 +83,12 @@ public:
     const QString &absolutePath() const;
     void setAbsolutePath(const QString &newAbsolutePath);
 
-    const QSet<int> &tagIds() const;
+    QSet<int> tagIds() const;
     void setTagIds(const QSet<int> &newTagIds);
+    const TagIdList &tagIdList() const;
+    void setTagIdList(const TagIdList &newTagIds);
+    bool hasTags() const;
+    bool hasTag(int tagId) const;
 
     bool isTempNote() const;
     void setIsTempNote(bool newIsTempNote);
@@ -79,29 +108,26 @@ public:
     int childNotesCount() const;
     void setChildNotesCount(int newChildCount);
 
+    const QString &displayTitle() const;
+    void setDisplayTitle(const QString &newDisplayTitle);
+
+    const QString &preview() const;
+    void setPreview(const QString &newPreview);
+
+    bool isContentLoaded() const;
+    void setIsContentLoaded(bool newIsContentLoaded);
+
+    static QString getNthLine(const QString &str, int targetLineNumber);
+    static QString getFirstLine(const QString &str);
+    static QString getSecondLine(const QString &str);
+    static QString getDisplayTitle(const QString &fullTitle);
+    static bool getLineDisplayText(const QString &line, QString &text);
+
 private:
-    int m_id;
-    QString m_fullTitle;
-    QDateTime m_lastModificationDateTime;
-    QDateTime m_creationDateTime;
-    QDateTime m_deletionDateTime;
-    QString m_content;
-    bool m_isModified;
-    bool m_isSelected;
-    int m_scrollBarPosition;
-    NodeData::Type m_nodeType;
-    int m_parentId;
-    int m_relativePosition;
-    QString m_absolutePath;
-    QSet<int> m_tagIds;
-    bool m_isTempNote;
-    QString m_parentName;
-    bool m_isPinnedNote;
-    int m_tagListScrollBarPos;
-    int m_relativePosAN;
-    int m_childNotesCount;
+    QSharedDataPointer<NodeDataPrivate> d;
 };
 
+Q_DECLARE_TYPEINFO(NodeData, Q_RELOCATABLE_TYPE);
 Q_DECLARE_METATYPE(NodeData)
 
 QDataStream &operator>>(QDataStream &stream, NodeData &nodeData);
@@ -2,12 +2,34 @@
 #include <QDebug>
 #include <QRegularExpression>
 #include <QMimeData>
+#include <QSet>
+#include <utility>
 
 namespace {
 auto constexpr COLUMN_COUNT = 1;
+// above this many added, removed or reparented folders and tags a reset is cheaper than a diff
+auto constexpr TREE_DIFF_MAX_CHANGES = 256;
+
+quint64 itemKey(const NodeTreeItem *item)
+{
+    return (static_cast<quint64>(item->itemType()) << 32) | static_cast<quint32>(item->nodeId());
+}
+
+bool isSameItemData(const NodeTreeItemData &lhs, const NodeTreeItemData &rhs)
+{
+    return lhs.relPos == rhs.relPos && lhs.childCount == rhs.childCount && lhs.title == rhs.title && lhs.absPath == rhs.absPath
+            && lhs.tagColor == rhs.tagColor && lhs.icon == rhs.icon;
 }
+} // namespace
 
-NodeTreeItem::NodeTreeItem(const QHash<NodeItem::Roles, QVariant> &data, NodeTreeItem *parentItem) : m_itemData(data), m_parentItem(parentItem) { }
+NodeTreeItem::NodeTreeItem(const NodeTreeItemData &data, NodeTreeItem *parentItem) : m_itemData(data), m_parentItem(parentItem), m_row(0) { }
+
+NodeTreeItem::NodeTreeItem(const QHash<NodeItem::Roles, QVariant> &data, NodeTreeItem *parentItem) : m_parentItem(parentItem), m_row(0)
+{
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
+        setData(it.key(), it.value());
+    }
+}
 
 NodeTreeItem::~NodeTreeItem()
 {
@@ -16,12 +38,14 @@ NodeTreeItem::~NodeTreeItem()
 
 void NodeTreeItem::appendChild(NodeTreeItem *child)
 {
+    child->m_row = m_childItems.size();
     m_childItems.append(child);
 }
 
 void NodeTreeItem::insertChild(int row, NodeTreeItem *child)
 {
     m_childItems.insert(row, child);
+    updateChildRows(row, m_childItems.size() - 1);
 }
 
 NodeTreeItem *NodeTreeItem::getChild(int row) const
@@ -38,6 +62,12 @@ void NodeTreeItem::removeChild(int row)
         return;
     }
     delete m_childItems.takeAt(row);
+    updateChildRows(row, m_childItems.size() - 1);
+}
+
+QVector<NodeTreeItem *> NodeTreeItem::takeChildren()
+{
+    return std::exchange(m_childItems, {});
 }
 
 NodeTreeItem *NodeTreeItem::takeChildAt(int row)
@@ -45,7 +75,9 @@ NodeTreeItem *NodeTreeItem::takeChildAt(int row)
     if (row < 0 || row >= m_childItems.size()) {
         return nullptr;
     }
-    return m_childItems.takeAt(row);
+    auto *child = m_childItems.takeAt(row);
+    updateChildRows(row, m_childItems.size() - 1);
+    return child;
 }
 
 int NodeTreeItem::getChildCount() const
@@ -70,13 +102,11 @@ int NodeTreeItem::recursiveNodeCount() const
 void NodeTreeItem::recursiveUpdateFolderPath(const QString &oldP, const QString &newP)
 {
     {
-        auto type = static_cast<NodeItem::Type>(getData(NodeItem::Roles::ItemType).toInt());
-        if (type != NodeItem::Type::FolderItem) {
+        if (m_itemData.type != NodeItem::Type::FolderItem) {
             return;
         }
-        auto currP = getData(NodeItem::Roles::AbsPath).toString();
+        auto &currP = m_itemData.absPath;
         currP.replace(currP.indexOf(oldP), oldP.size(), newP);
-        setData(NodeItem::Roles::AbsPath, currP);
     }
     for (auto &child : m_childItems) {
         child->recursiveUpdateFolderPath(oldP, newP);
@@ -85,12 +115,95 @@ void NodeTreeItem::recursiveUpdateFolderPath(const QString &oldP, const QString
 
 QVariant NodeTreeItem::getData(NodeItem::Roles role) const
 {
-    return m_itemData.value(role, QVariant());
+    switch (role) {
+    case NodeItem::Roles::ItemType:
+        return m_itemData.type;
+    case NodeItem::Roles::DisplayText:
+        return m_itemData.title;
+    case NodeItem::Roles::NodeId:
+        return m_itemData.id;
+    case NodeItem::Roles::RelPos:
+        return m_itemData.relPos;
+    case NodeItem::Roles::ChildCount:
+        return m_itemData.childCount;
+    // Unset strings stay invalid so views fall back to their defaults
+    case NodeItem::Roles::AbsPath:
+        return m_itemData.absPath.isNull() ? QVariant() : m_itemData.absPath;
+    case NodeItem::Roles::TagColor:
+        return m_itemData.tagColor.isNull() ? QVariant() : m_itemData.tagColor;
+    case NodeItem::Roles::Icon:
+        return m_itemData.icon.isNull() ? QVariant() : m_itemData.icon;
+    default:
+        return {};
+    }
 }
 
 void NodeTreeItem::setData(NodeItem::Roles role, const QVariant &d)
 {
-    m_itemData[role] = d;
+    switch (role) {
+    case NodeItem::Roles::ItemType:
+        m_itemData.type = static_cast<NodeItem::Type>(d.toInt());
+        break;
+    case NodeItem::Roles::DisplayText:
+        m_itemData.title = d.toString();
+        break;
+    case NodeItem::Roles::NodeId:
+        m_itemData.id = d.toInt();
+        break;
+    case NodeItem::Roles::RelPos:
+        m_itemData.relPos = d.toInt();
+        break;
+    case NodeItem::Roles::ChildCount:
+        m_itemData.childCount = d.toInt();
+        break;
+    case NodeItem::Roles::AbsPath:
+        m_itemData.absPath = d.toString();
+        break;
+    case NodeItem::Roles::TagColor:
+        m_itemData.tagColor = d.toString();
+        break;
+    case NodeItem::Roles::Icon:
+        m_itemData.icon = d.toString();
+        break;
+    default:
+        qDebug() << __FUNCTION__ << __LINE__ << "role not stored in tree item" << static_cast<int>(role);
+        break;
+    }
+}
+
+const NodeTreeItemData &NodeTreeItem::itemData() const
+{
+    return m_itemData;
+}
+
+void NodeTreeItem::setItemData(const NodeTreeItemData &data)
+{
+    m_itemData = data;
+}
+
+NodeItem::Type NodeTreeItem::itemType() const
+{
+    return m_itemData.type;
+}
+
+int NodeTreeItem::nodeId() const
+{
+    return m_itemData.id;
+}
+
+int NodeTreeItem::relativePosition() const
+{
+    return m_itemData.relPos;
+}
+
+const QString &NodeTreeItem::displayText() const
+{
+    return m_itemData.title;
+}
+
+const QString &NodeTreeItem::absolutePath() const
+{
+    return m_itemData.absPath;
 }
 
 NodeTreeItem *NodeTreeItem::getParentItem() const
@@ -106,16 +219,23 @@ void NodeTreeItem::setParentItem(NodeTreeItem *parentItem)
 void NodeTreeItem::moveChild(int from, int to)
 {
     m_childItems.move(from, to);
+    updateChildRows(qMin(from, to), qMax(from, to));
+}
+
+void NodeTreeItem::updateChildRows(int from, int to)
+{
+    for (int i = from; i <= to; ++i) {
+        m_childItems[i]->m_row = i;
+    }
 }
 
 void NodeTreeItem::recursiveSort()
 {
-    auto type = static_cast<NodeItem::Type>(getData(NodeItem::Roles::ItemType).toInt());
-    auto relPosComparator = [](const NodeTreeItem *a, const NodeTreeItem *b) {
-        return a->getData(NodeItem::Roles::RelPos).toInt() < b->getData(NodeItem::Roles::RelPos).toInt();
-    };
+    auto type = m_itemData.type;
+    auto relPosComparator = [](const NodeTreeItem *a, const NodeTreeItem *b) { return a->m_itemData.relPos < b->m_itemData.relPos; };
     if (type == NodeItem::Type::FolderItem) {
         std::sort(m_childItems.begin(), m_childItems.end(), relPosComparator);
+        updateChildRows(0, m_childItems.size() - 1);
         for (auto &child : m_childItems) {
             child->recursiveSort();
         }
@@ -127,7 +247,7 @@ void NodeTreeItem::recursiveSort()
         QVector<NodeTreeItem *> tagSep;
         QVector<NodeTreeItem *> tagItems;
         for (auto *const child : std::as_const(m_childItems)) {
-            auto childType = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
+            auto childType = child->itemType();
             if (childType == NodeItem::Type::AllNoteButton) {
                 allNoteButton.append(child);
             } else if (childType == NodeItem::Type::TrashButton) {
@@ -156,13 +276,14 @@ void NodeTreeItem::recursiveSort()
         m_childItems.append(folderItems);
         m_childItems.append(tagSep);
         m_childItems.append(tagItems);
+        updateChildRows(0, m_childItems.size() - 1);
     }
 }
 
 int NodeTreeItem::getRow() const
 {
     if (m_parentItem != nullptr) {
-        return m_parentItem->m_childItems.indexOf(const_cast<NodeTreeItem *>(this));
+        return m_row;
     }
 
     return 0;
@@ -170,9 +291,10 @@ int NodeTreeItem::getRow() const
 
 NodeTreeModel::NodeTreeModel(QObject *parent) : QAbstractItemModel(parent), m_rootItem(nullptr)
 {
-    auto hs = QHash<NodeItem::Roles, QVariant>{};
-    hs[NodeItem::Roles::ItemType] = NodeItem::Type::RootItem;
-    m_rootItem = new NodeTreeItem(hs);
+    NodeTreeItemData rootData;
+    rootData.type = NodeItem::Type::RootItem;
+    rootData.id = ROOT_FOLDER_ID;
+    m_rootItem = new NodeTreeItem(rootData);
 }
 
 NodeTreeModel::~NodeTreeModel()
@@ -191,8 +313,8 @@ void NodeTreeModel::appendChildNodeToParent(const QModelIndex &parentIndex, cons
                 int row = 0;
                 for (int i = 0; i < parentItem->getChildCount(); ++i) {
                     auto const *childItem = parentItem->getChild(i);
-                    auto childType = static_cast<NodeItem::Type>(childItem->getData(NodeItem::Roles::ItemType).toInt());
-                    if (childType == NodeItem::Type::FolderItem && childItem->getData(NodeItem::Roles::NodeId).toInt() == DEFAULT_NOTES_FOLDER_ID) {
+                    auto childType = childItem->itemType();
+                    if (childType == NodeItem::Type::FolderItem && childItem->nodeId() == DEFAULT_NOTES_FOLDER_ID) {
                         row = i + 1;
                         break;
                     }
@@ -201,6 +323,7 @@ void NodeTreeModel::appendChildNodeToParent(const QModelIndex &parentIndex, cons
                 beginInsertRows(parentIndex, row, row);
                 auto *nodeItem = new NodeTreeItem(data, parentItem);
                 parentItem->insertChild(row, nodeItem);
+                indexItem(nodeItem);
                 endInsertRows();
                 emit layoutChanged();
                 emit topLevelItemLayoutChanged();
@@ -209,6 +332,7 @@ void NodeTreeModel::appendChildNodeToParent(const QModelIndex &parentIndex, cons
                 beginInsertRows(parentIndex, 0, 0);
                 auto *nodeItem = new NodeTreeItem(data, parentItem);
                 parentItem->insertChild(0, nodeItem);
+                indexItem(nodeItem);
                 endInsertRows();
                 updateChildRelativePosition(parentItem, NodeItem::Type::FolderItem);
             }
@@ -222,7 +346,7 @@ void NodeTreeModel::appendChildNodeToParent(const QModelIndex &parentIndex, cons
             int row = 0;
             for (int i = 0; i < parentItem->getChildCount(); ++i) {
                 auto const *childItem = parentItem->getChild(i);
-                auto childType = static_cast<NodeItem::Type>(childItem->getData(NodeItem::Roles::ItemType).toInt());
+                auto childType = childItem->itemType();
                 if (childType == NodeItem::Type::TagSeparator) {
                     row = i + 1;
                     break;
@@ -232,6 +356,7 @@ void NodeTreeModel::appendChildNodeToParent(const QModelIndex &parentIndex, cons
             beginInsertRows(parentIndex, row, row);
             auto *nodeItem = new NodeTreeItem(data, parentItem);
             parentItem->insertChild(row, nodeItem);
+            indexItem(nodeItem);
             endInsertRows();
             emit layoutChanged();
             emit topLevelItemLayoutChanged();
@@ -302,7 +427,7 @@ QVariant NodeTreeModel::data(const QModelIndex &index, int role) const
     if (static_cast<NodeItem::Roles>(role) == NodeItem::Roles::IsExpandable) {
         return item->getChildCount() > 0;
     }
-    if (item->getData(NodeItem::Roles::ItemType) == NodeItem::Type::RootItem) {
+    if (item->itemType() == NodeItem::Type::RootItem) {
         return {};
     }
     return item->getData(static_cast<NodeItem::Roles>(role));
@@ -319,7 +444,8 @@ QModelIndex NodeTreeModel::folderIndexFromIdPath(const NodePath &idPath)
         return {};
     }
     auto ps = idPath.separate();
-    auto const *item = m_rootItem;
+    QVector<int> ids;
+    ids.reserve(ps.size());
     for (const auto &ite : std::as_const(ps)) {
         bool ok = false;
         auto id = ite.toInt(&ok);
@@ -327,38 +453,42 @@ QModelIndex NodeTreeModel::folderIndexFromIdPath(const NodePath &idPath)
             qDebug() << __FUNCTION__ << "Can't convert to id" << ite;
             return {};
         }
-        if (id == item->getData(NodeItem::Roles::NodeId).toInt()) {
-            continue;
-        }
-        bool foundChild = false;
-        for (int i = 0; i < item->getChildCount(); ++i) {
-            auto *child = item->getChild(i);
-            if (static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt()) != NodeItem::FolderItem) {
-                continue;
-            }
-            if (id == child->getData(NodeItem::Roles::NodeId).toInt()) {
-                item = child;
-                foundChild = true;
-                break;
+        ids.append(id);
+    }
+    if (ids.isEmpty() || ids.last() == ROOT_FOLDER_ID) {
+        return createIndex(m_rootItem->getRow(), 0, m_rootItem);
+    }
+    auto *item = m_folderItems.value(ids.last(), nullptr);
+    if (item == nullptr) {
+        return {};
+    }
+    // The id lookup is O(1), the path still has to match the item's ancestors
+    auto const *ancestor = item;
+    for (int i = ids.size() - 1; i >= 0; --i) {
+        if (ancestor == m_rootItem) {
+            if (ids[i] != ROOT_FOLDER_ID) {
+                return {};
             }
+            continue;
         }
-        if (!foundChild) {
+        if ((ancestor == nullptr) || ancestor->nodeId() != ids[i]) {
             return {};
         }
+        ancestor = ancestor->getParentItem();
+    }
+    if (ancestor != m_rootItem) {
+        return {};
     }
     return createIndex(item->getRow(), 0, item);
 }
 
 QModelIndex NodeTreeModel::tagIndexFromId(int id)
 {
-    for (int i = 0; i < m_rootItem->getChildCount(); ++i) {
-        auto *child = m_rootItem->getChild(i);
-        if (static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt()) == NodeItem::Type::TagItem
-            && (static_cast<int>(child->getData(NodeItem::Roles::NodeId).toInt() == id) != 0)) {
-            return createIndex(i, 0, child);
-        }
+    auto *item = m_tagItems.value(id, nullptr);
+    if (item == nullptr) {
+        return {};
     }
-    return {};
+    return createIndex(item->getRow(), 0, item);
 }
 
 QString NodeTreeModel::getNewFolderPlaceholderName(const QModelIndex &parentIndex)
@@ -371,7 +501,7 @@ QString NodeTreeModel::getNewFolderPlaceholderName(const QModelIndex &parentInde
             int n = 0;
             for (int i = 0; i < parentItem->getChildCount(); ++i) {
                 auto const *child = parentItem->getChild(i);
-                QString title = child->getData(NodeItem::Roles::DisplayText).toString();
+                QString title = child->displayText();
                 if (title.compare("New Folder", Qt::CaseInsensitive) == 0 && n == 0) {
                     n = 1;
                 }
@@ -399,7 +529,7 @@ QString NodeTreeModel::getNewTagPlaceholderName()
         int n = 0;
         for (int i = 0; i < m_rootItem->getChildCount(); ++i) {
             auto const *child = m_rootItem->getChild(i);
-            auto title = child->getData(NodeItem::Roles::DisplayText).toString();
+            auto title = child->displayText();
             if (title.compare("New Tag", Qt::CaseInsensitive) == 0 && n == 0) {
                 n = 1;
             }
@@ -425,7 +555,7 @@ QVector<QModelIndex> NodeTreeModel::getSeparatorIndex()
     if (m_rootItem != nullptr) {
         for (int i = 0; i < m_rootItem->getChildCount(); ++i) {
             auto *child = m_rootItem->getChild(i);
-            auto type = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
+            auto type = child->itemType();
             if (type == NodeItem::Type::FolderSeparator || type == NodeItem::Type::TagSeparator) {
                 result.append(createIndex(i, 0, child));
             }
@@ -436,14 +566,9 @@ QVector<QModelIndex> NodeTreeModel::getSeparatorIndex()
 
 QModelIndex NodeTreeModel::getDefaultNotesIndex()
 {
-    if (m_rootItem != nullptr) {
-        for (int i = 0; i < m_rootItem->getChildCount(); ++i) {
-            auto *child = m_rootItem->getChild(i);
-            auto type = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
-            if (type == NodeItem::Type::FolderItem && child->getData(NodeItem::Roles::NodeId).toInt() == DEFAULT_NOTES_FOLDER_ID) {
-                return createIndex(i, 0, child);
-            }
-        }
+    auto *item = m_folderItems.value(DEFAULT_NOTES_FOLDER_ID, nullptr);
+    if (item != nullptr && item->getParentItem() == m_rootItem) {
+        return createIndex(item->getRow(), 0, item);
     }
     return QModelIndex{};
 }
@@ -453,7 +578,7 @@ QModelIndex NodeTreeModel::getAllNotesButtonIndex()
     if (m_rootItem != nullptr) {
         for (int i = 0; i < m_rootItem->getChildCount(); ++i) {
             auto *child = m_rootItem->getChild(i);
-            auto type = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
+            auto type = child->itemType();
             if (type == NodeItem::Type::AllNoteButton) {
                 return createIndex(i, 0, child);
             }
@@ -467,7 +592,7 @@ QModelIndex NodeTreeModel::getTrashButtonIndex()
     if (m_rootItem != nullptr) {
         for (int i = 0; i < m_rootItem->getChildCount(); ++i) {
             auto *child = m_rootItem->getChild(i);
-            auto type = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
+            auto type = child->itemType();
             if (type == NodeItem::Type::TrashButton) {
                 return createIndex(i, 0, child);
             }
@@ -489,6 +614,7 @@ void NodeTreeModel::deleteRow(const QModelIndex &rowIndex, const QModelIndex &pa
     int row = item->getRow();
 
     setData(rowIndex, "deleted", NodeItem::DisplayText);
+    unindexItem(item);
     if (parentItem == m_rootItem) {
         beginResetModel();
         parentItem->removeChild(row);
@@ -502,43 +628,226 @@ void NodeTreeModel::deleteRow(const QModelIndex &rowIndex, const QModelIndex &pa
     }
 }
 
+/*!
+ * \brief NodeTreeModel::setChildNotesCounts
+ * Applies a batch of badge counts, keyed by folder and tag id. Changed rows
+ * are reported with one dataChanged per parent item.
+ */
+void NodeTreeModel::setChildNotesCounts(const QHash<int, int> &folderCounts, const QHash<int, int> &tagCounts)
+{
+    QHash<NodeTreeItem *, QPair<int, int>> changedRows;
+    auto updateCount = [&changedRows](NodeTreeItem *item, int count) {
+        if (item == nullptr || item->itemData().childCount == count) {
+            return;
+        }
+        item->setData(NodeItem::Roles::ChildCount, count);
+        auto *parentItem = item->getParentItem();
+        int row = item->getRow();
+        auto it = changedRows.find(parentItem);
+        if (it == changedRows.end()) {
+            changedRows.insert(parentItem, qMakePair(row, row));
+        } else {
+            it->first = qMin(it->first, row);
+            it->second = qMax(it->second, row);
+        }
+    };
+    for (auto it = folderCounts.constBegin(); it != folderCounts.constEnd(); ++it) {
+        QModelIndex index;
+        if (it.key() == ROOT_FOLDER_ID) {
+            index = getAllNotesButtonIndex();
+        } else if (it.key() == TRASH_FOLDER_ID) {
+            index = getTrashButtonIndex();
+        }
+        auto *item = index.isValid() ? static_cast<NodeTreeItem *>(index.internalPointer()) : m_folderItems.value(it.key(), nullptr);
+        updateCount(item, it.value());
+    }
+    for (auto it = tagCounts.constBegin(); it != tagCounts.constEnd(); ++it) {
+        updateCount(m_tagItems.value(it.key(), nullptr), it.value());
+    }
+    for (auto it = changedRows.constBegin(); it != changedRows.constEnd(); ++it) {
+        auto *parentItem = it.key();
+        auto parentIndex = parentItem == m_rootItem ? QModelIndex() : createIndex(parentItem->getRow(), 0, parentItem);
+        emit dataChanged(index(it->first, 0, parentIndex), index(it->second, 0, parentIndex), { NodeItem::Roles::ChildCount });
+    }
+}
+
+/*!
+ * \brief NodeTreeModel::setTreeData
+ * Once a tree is loaded, a new one is merged into it by id with targeted
+ * row signals, so the view keeps its expansion, selection and scroll
+ * position. The first load, or one that changes too much, resets the model.
+ * \param treeData
+ */
 void NodeTreeModel::setTreeData(const NodeTagTreeData &treeData)
 {
+    NodeTreeItemData rootData;
+    rootData.type = NodeItem::Type::RootItem;
+    rootData.id = ROOT_FOLDER_ID;
+    auto *newRoot = new NodeTreeItem(rootData);
+    appendAllNotesAndTrashButton(newRoot);
+    appendFolderSeparator(newRoot);
+    loadNodeTree(treeData.nodeTreeData, newRoot);
+    appendTagsSeparator(newRoot);
+    loadTagList(treeData.tagTreeData, newRoot);
+    newRoot->recursiveSort();
+
+    if (m_rootItem->getChildCount() > 0) {
+        int changes = 0;
+        int survivors = 0;
+        countTreeChanges(newRoot, changes, survivors);
+        changes += m_folderItems.size() + m_tagItems.size() - survivors;
+        if (changes <= TREE_DIFF_MAX_CHANGES) {
+            applyTreeChildren(m_rootItem, QModelIndex(), newRoot);
+            delete newRoot;
+            return;
+        }
+    }
+
     beginResetModel();
     delete m_rootItem;
-    auto hs = QHash<NodeItem::Roles, QVariant>{};
-    hs[NodeItem::Roles::ItemType] = NodeItem::Type::RootItem;
-    m_rootItem = new NodeTreeItem(hs);
-    appendAllNotesAndTrashButton(m_rootItem);
-    appendFolderSeparator(m_rootItem);
-    loadNodeTree(treeData.nodeTreeData, m_rootItem);
-    appendTagsSeparator(m_rootItem);
-    loadTagList(treeData.tagTreeData, m_rootItem);
-    m_rootItem->recursiveSort();
+    m_rootItem = newRoot;
+    m_folderItems.clear();
+    m_tagItems.clear();
+    indexItem(m_rootItem);
     endResetModel();
 }
 
+void NodeTreeModel::countTreeChanges(const NodeTreeItem *newItem, int &changes, int &survivors) const
+{
+    for (int i = 0; i < newItem->getChildCount(); ++i) {
+        auto const *child = newItem->getChild(i);
+        if (child->itemType() == NodeItem::Type::FolderItem) {
+            auto const *item = m_folderItems.value(child->nodeId(), nullptr);
+            if (item != nullptr && item->getParentItem()->nodeId() == newItem->nodeId()) {
+                ++survivors;
+            } else {
+                ++changes;
+            }
+            countTreeChanges(child, changes, survivors);
+        } else if (child->itemType() == NodeItem::Type::TagItem) {
+            if (m_tagItems.contains(child->nodeId())) {
+                ++survivors;
+            } else {
+                ++changes;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief NodeTreeModel::applyTreeChildren
+ * Makes the children of parentItem match those of newItem. Items are matched
+ * by type and id; matched items are moved and updated in place, the others
+ * are removed or taken over from the new tree. newItem is left without
+ * children, so the caller can delete it.
+ */
+void NodeTreeModel::applyTreeChildren(NodeTreeItem *parentItem, const QModelIndex &parentIndex, NodeTreeItem *newItem)
+{
+    auto newChildren = newItem->takeChildren();
+    QSet<quint64> newKeys;
+    newKeys.reserve(newChildren.size());
+    for (auto const *child : std::as_const(newChildren)) {
+        newKeys.insert(itemKey(child));
+    }
+
+    for (int i = parentItem->getChildCount() - 1; i >= 0; --i) {
+        if (newKeys.contains(itemKey(parentItem->getChild(i)))) {
+            continue;
+        }
+        int last = i;
+        while (i > 0 && !newKeys.contains(itemKey(parentItem->getChild(i - 1)))) {
+            --i;
+        }
+        beginRemoveRows(parentIndex, i, last);
+        for (int row = last; row >= i; --row) {
+            unindexItem(parentItem->getChild(row));
+            parentItem->removeChild(row);
+        }
+        endRemoveRows();
+    }
+
+    for (int i = 0; i < newChildren.size(); ++i) {
+        auto *newChild = newChildren[i];
+        auto key = itemKey(newChild);
+        int from = -1;
+        for (int j = i; j < parentItem->getChildCount(); ++j) {
+            if (itemKey(parentItem->getChild(j)) == key) {
+                from = j;
+                break;
+            }
+        }
+        if (from == -1) {
+            beginInsertRows(parentIndex, i, i);
+            newChild->setParentItem(parentItem);
+            parentItem->insertChild(i, newChild);
+            indexItem(newChild);
+            endInsertRows();
+            continue;
+        }
+        if (from != i) {
+            beginMoveRows(parentIndex, from, from, parentIndex, i);
+            parentItem->moveChild(from, i);
+            endMoveRows();
+        }
+        auto *item = parentItem->getChild(i);
+        auto index = createIndex(i, 0, item);
+        // the button counts are not part of the tree data, they are set separately
+        auto type = item->itemType();
+        if ((type == NodeItem::Type::FolderItem || type == NodeItem::Type::TagItem || type == NodeItem::Type::NoteItem)
+            && !isSameItemData(item->itemData(), newChild->itemData())) {
+            item->setItemData(newChild->itemData());
+            emit dataChanged(index, index);
+        }
+        applyTreeChildren(item, index, newChild);
+        delete newChild;
+    }
+}
+
+void NodeTreeModel::indexItem(NodeTreeItem *item)
+{
+    if (item->itemType() == NodeItem::Type::FolderItem) {
+        m_folderItems[item->nodeId()] = item;
+    } else if (item->itemType() == NodeItem::Type::TagItem) {
+        m_tagItems[item->nodeId()] = item;
+    }
+    for (int i = 0; i < item->getChildCount(); ++i) {
+        indexItem(item->getChild(i));
+    }
+}
+
+void NodeTreeModel::unindexItem(const NodeTreeItem *item)
+{
+    auto &items = item->itemType() == NodeItem::Type::TagItem ? m_tagItems : m_folderItems;
+    auto it = items.find(item->nodeId());
+    if (it != items.end() && it.value() == item) {
+        items.erase(it);
+    }
+    for (int i = 0; i < item->getChildCount(); ++i) {
+        unindexItem(item->getChild(i));
+    }
+}
+
 void NodeTreeModel::loadNodeTree(const QVector<NodeData> &nodeData, NodeTreeItem *rootNode)
 {
     QHash<int, NodeTreeItem *> itemMap;
     itemMap[ROOT_FOLDER_ID] = rootNode;
     for (const auto &node : nodeData) {
         if (node.id() != ROOT_FOLDER_ID && node.id() != TRASH_FOLDER_ID && node.parentId() != TRASH_FOLDER_ID) {
-            auto hs = QHash<NodeItem::Roles, QVariant>{};
+            NodeTreeItemData itemData;
             if (node.nodeType() == NodeData::Type::Folder) {
-                hs[NodeItem::Roles::ItemType] = NodeItem::Type::FolderItem;
-                hs[NodeItem::Roles::AbsPath] = node.absolutePath();
-                hs[NodeItem::Roles::RelPos] = node.relativePosition();
-                hs[NodeItem::Roles::ChildCount] = node.childNotesCount();
+                itemData.type = NodeItem::Type::FolderItem;
+                itemData.absPath = node.absolutePath();
+                itemData.relPos = node.relativePosition();
+                itemData.childCount = node.childNotesCount();
             } else if (node.nodeType() == NodeData::Type::Note) {
-                hs[NodeItem::Roles::ItemType] = NodeItem::Type::NoteItem;
+                itemData.type = NodeItem::Type::NoteItem;
             } else {
                 qDebug() << "Wrong node type";
                 continue;
             }
-            hs[NodeItem::Roles::DisplayText] = node.fullTitle();
-            hs[NodeItem::Roles::NodeId] = node.id();
-            auto *nodeItem = new NodeTreeItem(hs, rootNode);
+            itemData.title = node.fullTitle();
+            itemData.id = node.id();
+            auto *nodeItem = new NodeTreeItem(itemData, rootNode);
             itemMap[node.id()] = nodeItem;
         }
     }
@@ -561,53 +870,53 @@ void NodeTreeModel::loadNodeTree(const QVector<NodeData> &nodeData, NodeTreeItem
 void NodeTreeModel::appendAllNotesAndTrashButton(NodeTreeItem *rootNode)
 {
     {
-        auto hs = QHash<NodeItem::Roles, QVariant>{};
-        hs[NodeItem::Roles::ItemType] = NodeItem::Type::AllNoteButton;
-        hs[NodeItem::Roles::DisplayText] = tr("All Notes");
-        hs[NodeItem::Roles::Icon] = u8"\ue2c7"; // folder
-        auto *allNodeButton = new NodeTreeItem(hs, rootNode);
+        NodeTreeItemData itemData;
+        itemData.type = NodeItem::Type::AllNoteButton;
+        itemData.title = tr("All Notes");
+        itemData.icon = u8"\ue2c7"; // folder
+        auto *allNodeButton = new NodeTreeItem(itemData, rootNode);
         rootNode->appendChild(allNodeButton);
     }
     {
-        auto hs = QHash<NodeItem::Roles, QVariant>{};
-        hs[NodeItem::Roles::ItemType] = NodeItem::Type::TrashButton;
-        hs[NodeItem::Roles::DisplayText] = tr("Trash");
-        hs[NodeItem::Roles::Icon] = u8"\uf1f8"; // fa-trash
-        auto *trashButton = new NodeTreeItem(hs, rootNode);
+        NodeTreeItemData itemData;
+        itemData.type = NodeItem::Type::TrashButton;
+        itemData.title = tr("Trash");
+        itemData.icon = u8"\uf1f8"; // fa-trash
+        auto *trashButton = new NodeTreeItem(itemData, rootNode);
         rootNode->appendChild(trashButton);
     }
 }
 
 void NodeTreeModel::appendFolderSeparator(NodeTreeItem *rootNode)
 {
-    auto hs = QHash<NodeItem::Roles, QVariant>{};
-    hs[NodeItem::Roles::ItemType] = NodeItem::Type::FolderSeparator;
-    hs[NodeItem::Roles::DisplayText] = tr("Folders");
-    auto *folderSepButton = new NodeTreeItem(hs, rootNode);
+    NodeTreeItemData itemData;
+    itemData.type = NodeItem::Type::FolderSeparator;
+    itemData.title = tr("Folders");
+    auto *folderSepButton = new NodeTreeItem(itemData, rootNode);
     rootNode->appendChild(folderSepButton);
 }
 
 void NodeTreeModel::appendTagsSeparator(NodeTreeItem *rootNode)
 {
-    auto hs = QHash<NodeItem::Roles, QVariant>{};
-    hs[NodeItem::Roles::ItemType] = NodeItem::Type::TagSeparator;
-    hs[NodeItem::Roles::DisplayText] = tr("Tags");
-    auto *tagSepButton = new NodeTreeItem(hs, rootNode);
+    NodeTreeItemData itemData;
+    itemData.type = NodeItem::Type::TagSeparator;
+    itemData.title = tr("Tags");
+    auto *tagSepButton = new NodeTreeItem(itemData, rootNode);
     rootNode->appendChild(tagSepButton);
 }
 
 void NodeTreeModel::loadTagList(const QVector<TagData> &tagData, NodeTreeItem *rootNode)
 {
     for (const auto &tag : tagData) {
-        auto hs = QHash<NodeItem::Roles, QVariant>{};
-        hs[NodeItem::Roles::ItemType] = NodeItem::Type::TagItem;
-        hs[NodeItem::Roles::DisplayText] = tag.name();
-        hs[NodeItem::Roles::TagColor] = tag.color();
-        hs[NodeItem::Roles::NodeId] = tag.id();
-        hs[NodeItem::Roles::RelPos] = tag.relativePosition();
-        hs[NodeItem::Roles::ChildCount] = tag.childNotesCount();
-
-        auto *tagItem = new NodeTreeItem(hs, rootNode);
+        NodeTreeItemData itemData;
+        itemData.type = NodeItem::Type::TagItem;
+        itemData.title = tag.name();
+        itemData.tagColor = tag.color();
+        itemData.id = tag.id();
+        itemData.relPos = tag.relativePosition();
+        itemData.childCount = tag.childNotesCount();
+
+        auto *tagItem = new NodeTreeItem(itemData, rootNode);
         rootNode->appendChild(tagItem);
     }
 }
@@ -617,13 +926,13 @@ void NodeTreeModel::updateChildRelativePosition(NodeTreeItem *parent, const Node
     int relId = 0;
     for (int i = 0; i < parent->getChildCount(); ++i) {
         auto const *child = parent->getChild(i);
-        auto childType = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
+        auto childType = child->itemType();
         if (childType == type) {
             if (type == NodeItem::Type::FolderItem) {
-                emit requestUpdateNodeRelativePosition(child->getData(NodeItem::Roles::NodeId).toInt(), relId);
+                emit requestUpdateNodeRelativePosition(child->nodeId(), relId);
                 ++relId;
             } else if (type == NodeItem::Type::TagItem) {
-                emit requestUpdateTagRelativePosition(child->getData(NodeItem::Roles::NodeId).toInt(), relId);
+                emit requestUpdateTagRelativePosition(child->nodeId(), relId);
                 ++relId;
             } else {
                 qDebug() << __FUNCTION__ << "Wrong type";
@@ -741,18 +1050,15 @@ bool NodeTreeModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
         QSet<int> movedIds;
         for (const auto &idString : std::as_const(idl)) {
             auto id = idString.toInt();
-            for (int i = 0; i < m_rootItem->getChildCount(); ++i) {
-                auto const *child = m_rootItem->getChild(i);
-                auto childType = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
-                if (childType == NodeItem::Type::TagItem && child->getData(NodeItem::Roles::NodeId).toInt() == id) {
-                    if (row >= m_rootItem->getChildCount()) {
-                        row = m_rootItem->getChildCount() - 1;
-                    }
-                    m_rootItem->moveChild(i, row);
-                    movedIds.insert(id);
-                    break;
-                }
+            auto const *child = m_tagItems.value(id, nullptr);
+            if (child == nullptr) {
+                continue;
+            }
+            if (row >= m_rootItem->getChildCount()) {
+                row = m_rootItem->getChildCount() - 1;
             }
+            m_rootItem->moveChild(child->getRow(), row);
+            movedIds.insert(id);
         }
         endResetModel();
         emit topLevelItemLayoutChanged();
@@ -782,13 +1088,13 @@ bool NodeTreeModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
         } else {
             parentItem = static_cast<NodeTreeItem *>(parent.internalPointer());
         }
-        auto parentType = static_cast<NodeItem::Type>(parentItem->getData(NodeItem::Roles::ItemType).toInt());
+        auto parentType = parentItem->itemType();
         if (parentType != NodeItem::Type::FolderItem && parentType != NodeItem::Type::RootItem && parentType != NodeItem::Type::TrashButton) {
             return false;
         }
         movingItem = static_cast<NodeTreeItem *>(idx.internalPointer());
         if (parentType == NodeItem::Type::TrashButton) {
-            auto abs = movingItem->getData(NodeItem::Roles::AbsPath).toString();
+            auto abs = movingItem->absolutePath();
             auto movingIndex = folderIndexFromIdPath(abs);
             emit requestMoveFolderToTrash(movingIndex);
             return false;
@@ -809,41 +1115,21 @@ bool NodeTreeModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
 
         if (movingItem->getParentItem() == parentItem) {
             beginResetModel();
-            for (int i = 0; i < parentItem->getChildCount(); ++i) {
-                auto const *child = parentItem->getChild(i);
-                auto childType = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
-                if (childType == NodeItem::Type::FolderItem && child->getData(NodeItem::Roles::NodeId) == movingItem->getData(NodeItem::Roles::NodeId)) {
-                    int targetRow = row;
-                    if (row > i && row > 0) {
-                        targetRow -= 1;
-                    }
-                    parentItem->moveChild(i, targetRow);
-                    break;
-                }
+            int i = movingItem->getRow();
+            int targetRow = row;
+            if (row > i && row > 0) {
+                targetRow -= 1;
             }
+            parentItem->moveChild(i, targetRow);
             endResetModel();
             emit topLevelItemLayoutChanged();
             updateChildRelativePosition(parentItem, NodeItem::Type::FolderItem);
-            emit dropFolderSuccessful(movingItem->getData(NodeItem::Roles::AbsPath).toString());
+            emit dropFolderSuccessful(movingItem->absolutePath());
         } else {
             auto *movingParent = movingItem->getParentItem();
-            int r = -1;
-            for (int i = 0; i < movingParent->getChildCount(); ++i) {
-                auto const *child = movingParent->getChild(i);
-                auto childType = static_cast<NodeItem::Type>(child->getData(NodeItem::Roles::ItemType).toInt());
-                if ((childType == NodeItem::Type::FolderItem)
-                    && (child->getData(NodeItem::Roles::NodeId).toInt() == movingItem->getData(NodeItem::Roles::NodeId).toInt())) {
-                    r = i;
-                    break;
-                }
-            }
-            if (r == -1) {
-                return false;
-            }
-            movingItem = movingParent->getChild(r);
-            auto oldAbsolutePath = movingItem->getData(NodeItem::Roles::AbsPath).toString();
-            QString newAbsolutePath = parentItem->getData(NodeItem::Roles::AbsPath).toString() + PATH_SEPARATOR
-                    + QString::number(movingItem->getData(NodeItem::Roles::NodeId).toInt());
+            int r = movingItem->getRow();
+            auto oldAbsolutePath = movingItem->absolutePath();
+            QString newAbsolutePath = parentItem->absolutePath() + PATH_SEPARATOR + QString::number(movingItem->nodeId());
             emit requestUpdateAbsPath(oldAbsolutePath, newAbsolutePath);
             beginResetModel();
             movingParent->takeChildAt(r);
@@ -852,10 +1138,10 @@ bool NodeTreeModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
             parentItem->insertChild(row, movingItem);
             endResetModel();
             emit topLevelItemLayoutChanged();
-            emit requestExpand(parentItem->getData(NodeItem::Roles::AbsPath).toString());
-            emit requestMoveNode(movingItem->getData(NodeItem::Roles::NodeId).toInt(), parentItem->getData(NodeItem::Roles::NodeId).toInt());
+            emit requestExpand(parentItem->absolutePath());
+            emit requestMoveNode(movingItem->nodeId(), parentItem->nodeId());
             updateChildRelativePosition(parentItem, NodeItem::Type::FolderItem);
-            emit dropFolderSuccessful(movingItem->getData(NodeItem::Roles::AbsPath).toString());
+            emit dropFolderSuccessful(movingItem->absolutePath());
         }
         return true;
     }
@@ -37,9 +37,27 @@ enum Type {
 };
 } // namespace NodeItem
 
+/*!
+ * \brief The NodeTreeItemData struct
+ * Typed storage behind a NodeTreeItem. Roles are only translated to and from
+ * QVariant by NodeTreeItem::getData/setData at the model boundary.
+ */
+struct NodeTreeItemData
+{
+    NodeItem::Type type{};
+    int id{ 0 };
+    int relPos{ 0 };
+    int childCount{ 0 };
+    QString title;
+    QString absPath;
+    QString tagColor;
+    QString icon;
+};
+
 class NodeTreeItem
 {
 public:
+    explicit NodeTreeItem(const NodeTreeItemData &data, NodeTreeItem *parentItem = nullptr);
     explicit NodeTreeItem(const QHash<NodeItem::Roles, QVariant> &data, NodeTreeItem *parentItem = nullptr);
     ~NodeTreeItem();
 
@@ -48,12 +66,20 @@ public:
     NodeTreeItem *getChild(int row) const;
     void removeChild(int row);
     NodeTreeItem *takeChildAt(int row);
+    QVector<NodeTreeItem *> takeChildren();
     int getChildCount() const;
     static int getColumnCount(); // columnCount is always 1 => static
     int recursiveNodeCount() const;
     void recursiveUpdateFolderPath(const QString &oldP, const QString &newP);
     QVariant getData(NodeItem::Roles role) const;
     void setData(NodeItem::Roles role, const QVariant &d);
+    const NodeTreeItemData &itemData() const;
+    void setItemData(const NodeTreeItemData &data);
+    NodeItem::Type itemType() const;
+    int nodeId() const;
+    int relativePosition() const;
+    const QString &displayText() const;
+    const QString &absolutePath() const;
     int getRow() const;
     NodeTreeItem *getParentItem() const;
     void setParentItem(NodeTreeItem *parentItem);
@@ -61,9 +87,12 @@ public:
     void recursiveSort();
 
 private:
+    void updateChildRows(int from, int to);
+
     QVector<NodeTreeItem *> m_childItems;
-    QHash<NodeItem::Roles, QVariant> m_itemData;
+    NodeTreeItemData m_itemData;
     NodeTreeItem *m_parentItem;
+    int m_row;
 };
 
 class NodeTreeModel : public QAbstractItemModel
@@ -84,6 +113,7 @@ public:
     QModelIndex getAllNotesButtonIndex();
     QModelIndex getTrashButtonIndex();
     void deleteRow(const QModelIndex &rowIndex, const QModelIndex &parentIndex);
+    void setChildNotesCounts(const QHash<int, int> &folderCounts, const QHash<int, int> &tagCounts);
 
 public slots:
     void setTreeData(const NodeTagTreeData &treeData);
@@ -116,6 +146,12 @@ signals:
 
 private:
     NodeTreeItem *m_rootItem;
+    QHash<int, NodeTreeItem *> m_folderItems;
+    QHash<int, NodeTreeItem *> m_tagItems;
+    void indexItem(NodeTreeItem *item);
+    void unindexItem(const NodeTreeItem *item);
+    void countTreeChanges(const NodeTreeItem *newItem, int &changes, int &survivors) const;
+    void applyTreeChildren(NodeTreeItem *parentItem, const QModelIndex &parentIndex, NodeTreeItem *newItem);
     void loadNodeTree(const QVector<NodeData> &nodeData, NodeTreeItem *rootNode);
     void appendAllNotesAndTrashButton(NodeTreeItem *rootNode);
     void appendFolderSeparator(NodeTreeItem *rootNode);
@@ -350,19 +350,23 @@ void NodeTreeView::dropEvent(QDropEvent *event)
         if (dropIndex.isValid()) {
             auto itemType = static_cast<NodeItem::Type>(dropIndex.data(NodeItem::Roles::ItemType).toInt());
             bool ok = false;
+            QSet<int> noteIds;
             auto idl = QString::fromUtf8(event->mimeData()->data(NOTE_MIME)).split(PATH_SEPARATOR);
             for (const auto &s : std::as_const(idl)) {
                 auto nodeId = s.toInt(&ok);
                 if (ok) {
-                    if (itemType == NodeItem::Type::FolderItem) {
-                        emit moveNodeRequested(nodeId, dropIndex.data(NodeItem::NodeId).toInt());
-                        event->acceptProposedAction();
-                    } else if (itemType == NodeItem::Type::TagItem) {
-                        emit addNoteToTag(nodeId, dropIndex.data(NodeItem::NodeId).toInt());
-                    } else if (itemType == NodeItem::Type::TrashButton) {
-                        emit moveNodeRequested(nodeId, TRASH_FOLDER_ID);
-                        event->acceptProposedAction();
-                    }
+                    noteIds.insert(nodeId);
+                }
+            }
+            if (!noteIds.isEmpty()) {
+                if (itemType == NodeItem::Type::FolderItem) {
+                    emit moveNotesRequested(noteIds, dropIndex.data(NodeItem::NodeId).toInt());
+                    event->acceptProposedAction();
+                } else if (itemType == NodeItem::Type::TagItem) {
+                    emit addNotesToTag(noteIds, dropIndex.data(NodeItem::NodeId).toInt());
+                } else if (itemType == NodeItem::Type::TrashButton) {
+                    emit moveNotesRequested(noteIds, TRASH_FOLDER_ID);
+                    event->acceptProposedAction();
                 }
             }
         }
@@ -3,6 +3,7 @@
 
 #include <QTreeView>
 #include <QTimer>
+#include <QSet>
 #include "nodedata.h"
 #include "editorsettingsoptions.h"
 
@@ -54,11 +55,11 @@ signals:
     void deleteNodeRequested(const QModelIndex &index);
     void loadNotesInFolderRequested(int folderID, bool isRecursive, bool notInterested = false, int scrollToId = INVALID_NODE_ID);
     void loadNotesInTagsRequested(const QSet<int> &tagIds, bool notInterested = false, int scrollToId = INVALID_NODE_ID);
-    void moveNodeRequested(int node, int target);
+    void moveNotesRequested(const QSet<int> &noteIds, int target);
     void renameTagRequested();
     void changeTagColorRequested(const QModelIndex &index);
     void deleteTagRequested(const QModelIndex &index);
-    void addNoteToTag(int noteId, int tagId);
+    void addNotesToTag(const QSet<int> &noteIds, int tagId);
     void saveExpand(const QStringList &ex);
     void saveSelected(bool isSelectingFolder, const QString &folder, const QSet<int> &tags);
     void saveLastSelectedNote();
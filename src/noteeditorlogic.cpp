@@ -6,15 +6,16 @@
 #include "taglistmodel.h"
 #include "tagpool.h"
 #include "taglistdelegate.h"
+#include "startuptrace.h"
 #include <QScrollBar>
 #include <QLabel>
 #include <QLineEdit>
 #include <QListWidget>
 #include <QDebug>
 #include <QCursor>
+#include <limits>
 
 namespace {
-auto constexpr FIRST_LINE_MAX = 80;
 }
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
@@ -32,15 +33,21 @@ NoteEditorLogic::NoteEditorLogic(CustomDocument *textEdit, QLabel *editorDateLab
       m_searchEdit{ searchEdit },
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
       m_kanbanWidget{ kanbanWidget },
+      m_isTaskIndexValid{ false },
+      m_kanbanColumnModel{ new KanbanColumnModel{ this } },
 #endif
       m_tagListView{ tagListView },
       m_dbManager{ dbManager },
       m_isContentModified{ false },
+      m_isDocumentDirty{ false },
+      m_isContentStale{ false },
+      m_documentRevision{ 0 },
       m_spacerColor{ 191, 191, 191 },
       m_currentAdaptableEditorPadding{ 0 },
       m_currentMinimumEditorPadding{ 0 }
 {
     connect(m_textEdit, &QTextEdit::textChanged, this, &NoteEditorLogic::onTextEditTextChanged);
+    connect(m_textEdit->document(), &QTextDocument::contentsChange, this, &NoteEditorLogic::onDocumentContentsChange);
     connect(this, &NoteEditorLogic::requestCreateUpdateNote, m_dbManager, &DBManager::onCreateUpdateRequestedNoteContent, Qt::QueuedConnection);
     // auto save timer
     m_autoSaveTimer.setSingleShot(true);
@@ -64,6 +71,9 @@ NoteEditorLogic::NoteEditorLogic(CustomDocument *textEdit, QLabel *editorDateLab
     connect(this, &NoteEditorLogic::showKanbanView, this, [this]() {
         if (m_kanbanWidget != nullptr) {
             emit setVisibilityOfFrameRightNonEditor(false);
+            // the board is loaded on first use and may have missed the
+            // selection state emitted by showNotesInEditor
+            emit checkMultipleNotesSelected(QVariant(m_currentNotes.size() > 1));
             bool shouldRecheck = checkForTasksInEditor();
             if (shouldRecheck) {
                 checkForTasksInEditor();
@@ -79,6 +89,7 @@ NoteEditorLogic::NoteEditorLogic(CustomDocument *textEdit, QLabel *editorDateLab
             emit setVisibilityOfFrameRightNonEditor(true);
             m_kanbanWidget->hide();
             m_textEdit->show();
+            resetKanbanColumns();
             emit clearKanbanModel();
             emit textShown();
         }
@@ -96,9 +107,37 @@ void NoteEditorLogic::setMarkdownEnabled(bool enabled)
     m_highlighter->setDocument(enabled ? m_textEdit->document() : nullptr);
 }
 
-void NoteEditorLogic::showNotesInEditor(const QVector<NodeData> &notes)
+void NoteEditorLogic::showNotesInEditor(const QVector<NodeData> &listNotes)
 {
+    // notes coming from the list only carry their preview, load the missing
+    // bodies here in a single request
+    QVector<NodeData> notes = listNotes;
     auto currentId = currentEditingNoteId();
+    QSet<int> unloadedIds;
+    for (auto &note : notes) {
+        // the list may lag behind the editor for the note being edited
+        if (currentId != INVALID_NODE_ID && note.id() == currentId) {
+            syncCurrentNoteContent();
+            note.setContent(m_currentNotes[0].content());
+            note.setIsContentLoaded(true);
+        } else if (!note.isContentLoaded() && !note.isTempNote()) {
+            unloadedIds.insert(note.id());
+        }
+    }
+    if (!unloadedIds.isEmpty()) {
+        NoteContentMap contents;
+        QMetaObject::invokeMethod(m_dbManager, "getNotesContent", Qt::BlockingQueuedConnection, Q_RETURN_ARG(NoteContentMap, contents),
+                                  Q_ARG(QSet<int>, unloadedIds));
+        for (auto &note : notes) {
+            if (unloadedIds.contains(note.id())) {
+                note.setContent(contents.value(note.id()));
+                note.setIsContentLoaded(true);
+            }
+        }
+    }
+    if (currentId != INVALID_NODE_ID && (notes.size() != 1 || notes[0].id() != currentId)) {
+        saveNoteToDB();
+    }
     if (notes.size() == 1 && notes[0].id() != INVALID_NODE_ID) {
         if (currentId != INVALID_NODE_ID && notes[0].id() != currentId) {
             emit noteEditClosed(m_currentNotes[0], false);
@@ -125,6 +164,9 @@ void NoteEditorLogic::showNotesInEditor(const QVector<NodeData> &notes)
         if (isTextChanged) {
             m_textEdit->setText(content);
         }
+        m_documentRevision = m_textEdit->document()->revision();
+        m_isDocumentDirty = false;
+        m_isContentStale = false;
         QString noteDate = dateTime.toString(Qt::ISODate);
         QString noteDateEditor = getNoteDateEditor(noteDate);
         m_editorDateLabel->setText(noteDateEditor);
@@ -135,8 +177,10 @@ void NoteEditorLogic::showNotesInEditor(const QVector<NodeData> &notes)
         m_textEdit->setTextInteractionFlags(Qt::TextEditorInteraction);
         m_textEdit->setFocusPolicy(Qt::StrongFocus);
         highlightSearch();
+        StartupTrace::instance()->markOnce(QStringLiteral("editor ready"));
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
         if (m_kanbanWidget != nullptr && m_kanbanWidget->isVisible()) {
+            resetKanbanColumns();
             emit clearKanbanModel();
             bool shouldRecheck = checkForTasksInEditor();
             if (shouldRecheck) {
@@ -195,23 +239,56 @@ void NoteEditorLogic::showNotesInEditor(const QVector<NodeData> &notes)
     }
 }
 
+/*!
+ * \brief NoteEditorLogic::onDocumentContentsChange
+ * Keeps the Kanban task index in step with the document and marks the
+ * document dirty for real edits. The highlighter also reports contents
+ * changes when it restyles blocks, but those leave the document revision
+ * untouched.
+ */
+void NoteEditorLogic::onDocumentContentsChange(int position, int charsRemoved, int charsAdded)
+{
+    if (charsRemoved == 0 && charsAdded == 0) {
+        return;
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+    updateTaskIndex(position, charsAdded);
+#else
+    Q_UNUSED(position);
+#endif
+    auto revision = m_textEdit->document()->revision();
+    if (revision != m_documentRevision) {
+        m_documentRevision = revision;
+        m_isDocumentDirty = true;
+    }
+}
+
+/*!
+ * \brief NoteEditorLogic::onTextEditTextChanged
+ * Runs on every keystroke, so it never serializes the whole document: title
+ * and preview come from the first blocks and the content itself is only
+ * read back when the note is saved
+ */
 void NoteEditorLogic::onTextEditTextChanged()
 {
     if (currentEditingNoteId() != INVALID_NODE_ID) {
         m_textEdit->blockSignals(true);
-        QString content = m_currentNotes[0].content();
-        if (m_textEdit->toPlainText() != content) {
+        if (m_isDocumentDirty) {
+            m_isDocumentDirty = false;
             // move note to the top of the list
             emit moveNoteToListViewTop(m_currentNotes[0]);
 
             // Get the new data
-            QString firstline = getFirstLine(m_textEdit->toPlainText());
+            QString firstline = getFirstLine(m_textEdit->document());
             QDateTime dateTime = QDateTime::currentDateTime();
             QString noteDate = dateTime.toString(Qt::ISODate);
             m_editorDateLabel->setText(NoteEditorLogic::getNoteDateEditor(noteDate));
-            // update note data
-            m_currentNotes[0].setContent(m_textEdit->toPlainText());
+            // update note data, the content is synced when the note is saved
+            m_isContentStale = true;
+            m_currentNotes[0].setIsContentLoaded(false);
             m_currentNotes[0].setFullTitle(firstline);
+            m_currentNotes[0].setDisplayTitle(NodeData::getDisplayTitle(firstline));
+            m_currentNotes[0].setPreview(getSecondLine(m_textEdit->document()));
             m_currentNotes[0].setLastModificationDateTime(dateTime);
             m_currentNotes[0].setIsTempNote(false);
             m_currentNotes[0].setScrollBarPosition(m_textEdit->verticalScrollBar()->value());
@@ -227,6 +304,15 @@ void NoteEditorLogic::onTextEditTextChanged()
     }
 }
 
+void NoteEditorLogic::syncCurrentNoteContent()
+{
+    if (m_isContentStale && currentEditingNoteId() != INVALID_NODE_ID) {
+        m_currentNotes[0].setContent(m_textEdit->toPlainText());
+        m_currentNotes[0].setIsContentLoaded(true);
+        m_isContentStale = false;
+    }
+}
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
 
 void NoteEditorLogic::rearrangeTasksInTextEditor(int startLinePosition, int endLinePosition, int newLinePosition)
@@ -292,24 +378,45 @@ void NoteEditorLogic::rearrangeColumnsInTextEditor(int startLinePosition, int en
     checkForTasksInEditor();
 }
 
-QMap<QString, int> NoteEditorLogic::getTaskDataInLine(const QString &line)
-{
-    QStringList taskExpressions = { "- [ ]", "- [x]", "* [ ]", "* [x]", "- [X]", "* [X]" };
-    QMap<QString, int> taskMatchLineData;
-    taskMatchLineData["taskMatchIndex"] = -1;
-
-    int taskMatchIndex = -1;
-    for (auto &taskExpression : taskExpressions) {
-        taskMatchIndex = line.indexOf(taskExpression);
-        if (taskMatchIndex != -1) {
-            taskMatchLineData["taskMatchIndex"] = taskMatchIndex;
-            taskMatchLineData["taskExpressionSize"] = taskExpression.size();
-            taskMatchLineData["taskChecked"] = taskExpression[3] == 'x' ? 1 : 0;
-            return taskMatchLineData;
+/*!
+ * \brief NoteEditorLogic::getTaskDataInLine
+ * Finds a task marker ("- [ ]", "* [x]", ...) in a single pass. When a line
+ * holds several markers the earlier entry of "- [ ]", "- [x]", "* [ ]",
+ * "* [x]", "- [X]", "* [X]" wins, then the leftmost occurrence of it.
+ */
+NoteEditorLogic::TaskMatch NoteEditorLogic::getTaskDataInLine(const QString &line)
+{
+    auto constexpr taskExpressionSize = 5;
+    TaskMatch match;
+    int bestPriority = std::numeric_limits<int>::max();
+    for (int i = 0; i + taskExpressionSize <= line.size(); ++i) {
+        QChar bullet = line[i];
+        if ((bullet != '-' && bullet != '*') || line[i + 1] != ' ' || line[i + 2] != '[' || line[i + 4] != ']') {
+            continue;
+        }
+        QChar mark = line[i + 3];
+        int priority;
+        if (mark == ' ') {
+            priority = bullet == '-' ? 0 : 2;
+        } else if (mark == 'x') {
+            priority = bullet == '-' ? 1 : 3;
+        } else if (mark == 'X') {
+            priority = bullet == '-' ? 4 : 5;
+        } else {
+            continue;
+        }
+        if (priority < bestPriority) {
+            bestPriority = priority;
+            match.index = i;
+            match.expressionSize = taskExpressionSize;
+            // only the lowercase mark counts as checked
+            match.checked = mark == 'x';
+            if (priority == 0) {
+                break;
+            }
         }
     }
-
-    return taskMatchLineData;
+    return match;
 }
 
 void NoteEditorLogic::checkTaskInLine(int lineNumber)
@@ -318,7 +425,7 @@ void NoteEditorLogic::checkTaskInLine(int lineNumber)
     QTextBlock block = document->findBlockByLineNumber(lineNumber);
 
     if (block.isValid()) {
-        int indexOfTaskInLine = getTaskDataInLine(block.text())["taskMatchIndex"];
+        int indexOfTaskInLine = getTaskDataInLine(block.text()).index;
         if (indexOfTaskInLine == -1)
             return;
         QTextCursor cursor(block);
@@ -336,7 +443,7 @@ void NoteEditorLogic::uncheckTaskInLine(int lineNumber)
     QTextBlock block = document->findBlockByLineNumber(lineNumber);
 
     if (block.isValid()) {
-        int indexOfTaskInLine = getTaskDataInLine(block.text())["taskMatchIndex"];
+        int indexOfTaskInLine = getTaskDataInLine(block.text()).index;
         if (indexOfTaskInLine == -1)
             return;
         QTextCursor cursor(block);
@@ -364,11 +471,11 @@ void NoteEditorLogic::updateTaskText(int startLinePosition, int endLinePosition,
     QTextDocument *document = m_textEdit->document();
     QTextBlock block = document->findBlockByLineNumber(startLinePosition);
     if (block.isValid()) {
-        QMap<QString, int> taskData = getTaskDataInLine(block.text());
-        int indexOfTaskInLine = taskData["taskMatchIndex"];
+        auto taskData = getTaskDataInLine(block.text());
+        int indexOfTaskInLine = taskData.index;
         if (indexOfTaskInLine == -1)
             return;
-        QString taskExpressionText = block.text().mid(0, taskData["taskMatchIndex"] + taskData["taskExpressionSize"]);
+        QString taskExpressionText = block.text().mid(0, taskData.index + taskData.expressionSize);
 
         QString newTextModified = newText;
         newTextModified.replace("\n\n", "\n");
@@ -527,110 +634,171 @@ void NoteEditorLogic::addUntitledColumnToTextEditor(int startLinePosition)
     }
 }
 
-void NoteEditorLogic::appendNewColumn(QJsonArray &data, QJsonObject &currentColumn, QString &currentTitle, QJsonArray &tasks)
+KanbanLine NoteEditorLogic::parseKanbanLine(const QString &line)
 {
-    if (!tasks.isEmpty()) {
-        currentColumn["title"] = currentTitle;
-        currentColumn["tasks"] = tasks;
-        currentColumn["columnEndLine"] = tasks.last()["taskEndLine"];
-        data.append(currentColumn);
-        currentColumn = QJsonObject();
-        tasks = QJsonArray();
+    KanbanLine kanbanLine;
+    QString lineTrimmed = line.trimmed();
+    if (lineTrimmed.startsWith("#")) {
+        // Header title
+        int countOfHashTags = lineTrimmed.count('#');
+        kanbanLine.kind = KanbanLine::Kind::Header;
+        kanbanLine.text = lineTrimmed.mid(countOfHashTags);
+        return kanbanLine;
     }
+    auto taskData = getTaskDataInLine(line);
+    if (lineTrimmed.endsWith("::") && taskData.index == -1) {
+        // Non-header text with double colons
+        kanbanLine.kind = KanbanLine::Kind::Header;
+        kanbanLine.text = line.left(line.indexOf("::")).trimmed();
+    } else if (taskData.index != -1) {
+        // Todo item
+        kanbanLine.kind = KanbanLine::Kind::Task;
+        kanbanLine.checked = taskData.checked;
+        kanbanLine.text = line.mid(taskData.index + taskData.expressionSize).trimmed();
+    } else if (!line.isEmpty()) {
+        kanbanLine.kind = KanbanLine::Kind::Text;
+        kanbanLine.text = lineTrimmed;
+    }
+    return kanbanLine;
+}
+
+void NoteEditorLogic::rebuildTaskIndex()
+{
+    QTextDocument *document = m_textEdit->document();
+    m_taskIndex.clear();
+    m_taskIndex.reserve(document->blockCount());
+    for (auto block = document->begin(); block.isValid(); block = block.next()) {
+        m_taskIndex.append(parseKanbanLine(block.text()));
+    }
+    m_isTaskIndexValid = true;
+}
+
+/*!
+ * \brief NoteEditorLogic::updateTaskIndex
+ * Re-parses only the blocks covered by a contents change. While the board is
+ * hidden the index is dropped instead and rebuilt when it's needed again.
+ */
+void NoteEditorLogic::updateTaskIndex(int position, int charsAdded)
+{
+    if (!m_isTaskIndexValid) {
+        return;
+    }
+    if (m_kanbanWidget == nullptr || !m_kanbanWidget->isVisible()) {
+        m_isTaskIndexValid = false;
+        m_taskIndex.clear();
+        return;
+    }
+    QTextDocument *document = m_textEdit->document();
+    QTextBlock firstBlock = document->findBlock(position);
+    QTextBlock lastBlock = document->findBlock(position + charsAdded);
+    if (!firstBlock.isValid()) {
+        m_isTaskIndexValid = false;
+        return;
+    }
+    if (!lastBlock.isValid()) {
+        lastBlock = document->lastBlock();
+    }
+    int first = firstBlock.blockNumber();
+    int newCount = lastBlock.blockNumber() - first + 1;
+    int oldCount = newCount - (document->blockCount() - m_taskIndex.size());
+    if (oldCount < 0 || first + oldCount > m_taskIndex.size()) {
+        m_isTaskIndexValid = false;
+        return;
+    }
+    if (newCount > oldCount) {
+        m_taskIndex.insert(first + oldCount, newCount - oldCount, KanbanLine{});
+    } else if (newCount < oldCount) {
+        m_taskIndex.remove(first + newCount, oldCount - newCount);
+    }
+    int i = first;
+    for (auto block = firstBlock; block.isValid() && i < first + newCount; block = block.next(), ++i) {
+        m_taskIndex[i] = parseKanbanLine(block.text());
+    }
+}
+
+void NoteEditorLogic::resetKanbanColumns()
+{
+    m_kanbanColumnModel->clear();
+}
+
+KanbanColumnModel *NoteEditorLogic::kanbanColumnModel() const
+{
+    return m_kanbanColumnModel;
 }
 
 // Check if there are any tasks in the current note.
-// If there are, sends the data to the kanban view.
-// Structure:
-// QJsonArray([
-// {
-//    "title":"TODO",
-//    "columnStartLine": 1
-//    "columnEndLine": 4
-//    "tasks":[
-//              {"checked":false,"text":"todo 1", "taskStartine": 3, "taskEndLine": 3},
-//              {"checked":false,"text":"todo 2", "taskStartine": 4, "taskEndLine": 4}}]
-// },
-// ])
+// If there are, pushes them into the kanban column model, built from the
+// per-block task index. The model only signals the columns and tasks that
+// changed, tasksFoundInEditor is emitted when columns or tasks were added or
+// removed so the board can refresh its totals.
 bool NoteEditorLogic::checkForTasksInEditor()
 {
-    QStringList lines = m_textEdit->toPlainText().split("\n");
-    QJsonArray data;
-    QJsonObject currentColumn;
-    QJsonArray tasks;
-    QString currentTitle = "";
-    bool isPreviousLineATask = false;
+    if (!m_isTaskIndexValid || m_taskIndex.size() != m_textEdit->document()->blockCount()) {
+        rebuildTaskIndex();
+    }
 
-    for (int i = 0; i < lines.size(); i++) {
-        const QString &line = lines[i];
-        QString lineTrimmed = line.trimmed();
+    QVector<KanbanColumn> columns;
+    KanbanColumn currentColumn;
+    bool isPreviousLineATask = false;
 
-        // Header title
-        if (lineTrimmed.startsWith("#")) {
-            if (!tasks.isEmpty() && currentTitle.isEmpty()) {
+    for (int i = 0; i < m_taskIndex.size(); i++) {
+        const KanbanLine &line = m_taskIndex[i];
+        switch (line.kind) {
+        case KanbanLine::Kind::Header: {
+            if (!currentColumn.tasks.isEmpty() && currentColumn.title.isEmpty()) {
                 // If we have only tasks without a header we insert one and call this function again
-                addUntitledColumnToTextEditor(tasks.first()["taskStartLine"].toInt());
+                addUntitledColumnToTextEditor(currentColumn.tasks.first().startLine);
                 return true;
             }
-            appendNewColumn(data, currentColumn, currentTitle, tasks);
-            currentColumn["columnStartLine"] = i;
-            int countOfHashTags = lineTrimmed.count('#');
-            currentTitle = lineTrimmed.mid(countOfHashTags);
-            isPreviousLineATask = false;
-        }
-        // Non-header text with double colons
-        else if (lineTrimmed.endsWith("::") && getTaskDataInLine(line)["taskMatchIndex"] == -1) {
-            if (!tasks.isEmpty() && currentTitle.isEmpty()) {
-                // If we have only tasks without a header we insert one and call this function again
-                addUntitledColumnToTextEditor(tasks.first()["taskStartLine"].toInt());
-                return true;
+            if (!currentColumn.tasks.isEmpty()) {
+                currentColumn.endLine = currentColumn.tasks.last().endLine;
+                columns.append(currentColumn);
             }
-            appendNewColumn(data, currentColumn, currentTitle, tasks);
-            currentColumn["columnStartLine"] = i;
-            QStringList parts = line.split("::");
-            currentTitle = parts[0].trimmed();
+            currentColumn = KanbanColumn{};
+            currentColumn.title = line.text;
+            currentColumn.startLine = i;
             isPreviousLineATask = false;
+            break;
         }
-        // Todo item
-        else {
-            QMap<QString, int> taskDataInLine = getTaskDataInLine(line);
-            int indexOfTaskInLine = taskDataInLine["taskMatchIndex"];
-
-            if (indexOfTaskInLine != -1) {
-                QJsonObject taskObject;
-                QString taskText = line.mid(indexOfTaskInLine + taskDataInLine["taskExpressionSize"]).trimmed();
-                taskObject["text"] = taskText;
-                taskObject["checked"] = taskDataInLine["taskChecked"] == 1;
-                taskObject["taskStartLine"] = i;
-                taskObject["taskEndLine"] = i;
-                tasks.append(taskObject);
-                isPreviousLineATask = true;
-            }
+        case KanbanLine::Kind::Task: {
+            KanbanTask task;
+            task.text = line.text;
+            task.checked = line.checked;
+            task.startLine = i;
+            task.endLine = i;
+            currentColumn.tasks.append(task);
+            isPreviousLineATask = true;
+            break;
+        }
+        case KanbanLine::Kind::Text: {
             // If it's a continues description of the task push current line's text to the last task
-            else if (!line.isEmpty() && isPreviousLineATask) {
-                if (!tasks.empty()) {
-                    QJsonObject newTask = tasks[tasks.size() - 1].toObject();
-                    QString newTaskText = QStringLiteral("%1  \n%2").arg(newTask["text"].toString(), lineTrimmed);
-                    // For markdown rendering a line break needs two white spaces
-                    newTask["text"] = newTaskText;
-                    newTask["taskEndLine"] = i;
-                    tasks[tasks.size() - 1] = newTask;
-                }
-            } else {
-                isPreviousLineATask = false;
+            if (isPreviousLineATask && !currentColumn.tasks.isEmpty()) {
+                KanbanTask &task = currentColumn.tasks.last();
+                // For markdown rendering a line break needs two white spaces
+                task.text = QStringLiteral("%1  \n%2").arg(task.text, line.text);
+                task.endLine = i;
             }
+            break;
+        }
+        case KanbanLine::Kind::Empty:
+            isPreviousLineATask = false;
+            break;
         }
     }
 
-    if (!tasks.isEmpty() && currentTitle.isEmpty()) {
+    if (!currentColumn.tasks.isEmpty() && currentColumn.title.isEmpty()) {
         // If we have only tasks without a header we insert one and call this function again
-        addUntitledColumnToTextEditor(tasks.first()["taskStartLine"].toInt());
+        addUntitledColumnToTextEditor(currentColumn.tasks.first().startLine);
         return true;
     }
+    if (!currentColumn.tasks.isEmpty()) {
+        currentColumn.endLine = currentColumn.tasks.last().endLine;
+        columns.append(currentColumn);
+    }
 
-    appendNewColumn(data, currentColumn, currentTitle, tasks);
-
-    emit tasksFoundInEditor(QVariant(data));
+    if (m_kanbanColumnModel->setColumns(columns)) {
+        emit tasksFoundInEditor();
+    }
 
     return false;
 }
@@ -692,7 +860,9 @@ int NoteEditorLogic::currentEditingNoteId() const
 void NoteEditorLogic::saveNoteToDB()
 {
     if (currentEditingNoteId() != INVALID_NODE_ID && m_isContentModified && !m_currentNotes[0].isTempNote()) {
+        syncCurrentNoteContent();
         emit requestCreateUpdateNote(m_currentNotes[0]);
+        emit updateNoteDataInList(m_currentNotes[0]);
         m_isContentModified = false;
     }
 }
@@ -743,57 +913,41 @@ void NoteEditorLogic::deleteCurrentNote()
     }
 }
 
-QString NoteEditorLogic::getNthLine(const QString &str, int targetLineNumber)
+/*!
+ * \brief NoteEditorLogic::getNthLine
+ * Same as the string version but walks the document blocks, so it stops
+ * as soon as the line is found instead of copying the whole note
+ */
+QString NoteEditorLogic::getNthLine(const QTextDocument *document, int targetLineNumber)
 {
     if (targetLineNumber < 1) {
         return tr("Invalid line number");
     }
 
-    int previousLineBreakIndex = -1;
     int lineCount = 0;
-    for (int i = 0; i <= str.length(); i++) {
-        if (i == str.length() || str[i] == '\n') {
+    for (auto block = document->begin(); block.isValid(); block = block.next()) {
+        // soft line breaks inside a block are plain line breaks in the saved text
+        const auto lines = block.text().split(QChar::LineSeparator);
+        for (const auto &line : lines) {
             lineCount++;
-            if (lineCount >= targetLineNumber && (i - previousLineBreakIndex > 1 || (i > 0 && i == str.length() && str[i - 1] != '\n'))) {
-                QString line = str.mid(previousLineBreakIndex + 1, i - previousLineBreakIndex - 1);
-                line = line.trimmed();
-                if (!line.isEmpty() && !line.startsWith("---") && !line.startsWith("```")) {
-                    QTextDocument doc;
-                    doc.setMarkdown(line);
-                    QString text = doc.toPlainText();
-                    if (text.length() > 1 && text.at(0) == '^') {
-                        text = text.mid(1);
-                    }
-                    if (text.isEmpty()) {
-                        return tr("No additional text");
-                    }
-                    QTextStream ts(&text);
-                    return ts.readLine(FIRST_LINE_MAX);
-                }
+            QString text;
+            if (lineCount >= targetLineNumber && !line.isEmpty() && NodeData::getLineDisplayText(line, text)) {
+                return text;
             }
-            previousLineBreakIndex = i;
         }
     }
 
     return tr("No additional text");
 }
 
-/*!
- * \brief NoteEditorLogic::getFirstLine
- * Get a string 'str' and return only the first line of it
- * If the string contain no text, return "New Note"
- * TODO: We might make it more efficient by not loading the entire string into the memory
- * \param str
- * \return
- */
-QString NoteEditorLogic::getFirstLine(const QString &str)
+QString NoteEditorLogic::getFirstLine(const QTextDocument *document)
 {
-    return getNthLine(str, 1);
+    return getNthLine(document, 1);
 }
 
-QString NoteEditorLogic::getSecondLine(const QString &str)
+QString NoteEditorLogic::getSecondLine(const QTextDocument *document)
 {
-    return getNthLine(str, 2);
+    return getNthLine(document, 2);
 }
 
 void NoteEditorLogic::setTheme(Theme::Value theme, QColor textColor, qreal fontSize)
@@ -816,7 +970,11 @@ void NoteEditorLogic::setTheme(Theme::Value theme, QColor textColor, qreal fontS
     }
     if (currentEditingNoteId() != INVALID_NODE_ID) {
         int verticalScrollBarValueToRestore = m_textEdit->verticalScrollBar()->value();
+        m_textEdit->blockSignals(true);
         m_textEdit->setText(m_textEdit->toPlainText()); // TODO: Update the text color without setting the text
+        m_textEdit->blockSignals(false);
+        m_documentRevision = m_textEdit->document()->revision();
+        m_isDocumentDirty = false;
         m_textEdit->verticalScrollBar()->setValue(verticalScrollBarValueToRestore);
     } else {
         int verticalScrollBarValueToRestore = m_textEdit->verticalScrollBar()->value();
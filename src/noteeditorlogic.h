@@ -8,13 +8,14 @@
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
 #  include <QWidget>
 #  include <QVariant>
-#  include <QJsonArray>
-#  include <QJsonObject>
 #  include <QRegularExpression>
 #endif
 
 #include "nodedata.h"
 #include "editorsettingsoptions.h"
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+#  include "kanbancolumnmodel.h"
+#endif
 
 class CustomDocument;
 class CustomMarkdownHighlighter;
@@ -26,6 +27,23 @@ class TagListModel;
 class TagPool;
 class TagListDelegate;
 class QListWidget;
+class QTextDocument;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+/*!
+ * \brief The KanbanLine struct
+ * What one document block means to the Kanban board, kept per block so that
+ * edits only re-parse the blocks they touch
+ */
+struct KanbanLine
+{
+    enum class Kind : uint8_t { Empty, Text, Header, Task };
+    Kind kind{ Kind::Empty };
+    bool checked{ false };
+    QString text;
+};
+#endif
+
 class NoteEditorLogic : public QObject
 {
     Q_OBJECT
@@ -48,9 +66,9 @@ public:
     int currentEditingNoteId() const;
     void deleteCurrentNote();
 
-    static QString getNthLine(const QString &str, int targetLineNumber);
-    static QString getFirstLine(const QString &str);
-    static QString getSecondLine(const QString &str);
+    static QString getNthLine(const QTextDocument *document, int targetLineNumber);
+    static QString getFirstLine(const QTextDocument *document);
+    static QString getSecondLine(const QTextDocument *document);
     void setTheme(Theme::Value theme, QColor textColor, qreal fontSize);
 
     int currentAdaptableEditorPadding() const;
@@ -58,10 +76,14 @@ public:
 
     int currentMinimumEditorPadding() const;
     void setCurrentMinimumEditorPadding(int newCurrentMinimumEditorPadding);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+    KanbanColumnModel *kanbanColumnModel() const;
+#endif
 
 public slots:
-    void showNotesInEditor(const QVector<NodeData> &notes);
+    void showNotesInEditor(const QVector<NodeData> &listNotes);
     void onTextEditTextChanged();
+    void onDocumentContentsChange(int position, int charsRemoved, int charsAdded);
     void closeEditor();
     void onNoteTagListChanged(int noteId, const QSet<int> &tagIds);
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
@@ -90,7 +112,7 @@ signals:
     void textShown();
     void kanbanShown();
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
-    void tasksFoundInEditor(QVariant data);
+    void tasksFoundInEditor();
     void clearKanbanModel();
     void resetKanbanSettings();
     void checkMultipleNotesSelected(QVariant isMultipleNotesSelected);
@@ -98,14 +120,26 @@ signals:
 
 private:
     static QDateTime getQDateTime(const QString &date);
+    void syncCurrentNoteContent();
     void showTagListForCurrentNote();
     bool isInEditMode() const;
     QString moveTextToNewLinePosition(const QString &inputText, int startLinePosition, int endLinePosition, int newLinePosition, bool isColumns = false);
-    QMap<QString, int> getTaskDataInLine(const QString &line);
+    struct TaskMatch
+    {
+        int index{ -1 };
+        int expressionSize{ 0 };
+        bool checked{ false };
+    };
+    static TaskMatch getTaskDataInLine(const QString &line);
     void replaceTextBetweenLines(int startLinePosition, int endLinePosition, QString &newText);
     void removeTextBetweenLines(int startLinePosition, int endLinePosition);
-    void appendNewColumn(QJsonArray &data, QJsonObject &currentColumn, QString &currentTitle, QJsonArray &tasks);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
     void addUntitledColumnToTextEditor(int startLinePosition);
+    static KanbanLine parseKanbanLine(const QString &line);
+    void rebuildTaskIndex();
+    void updateTaskIndex(int position, int charsAdded);
+    void resetKanbanColumns();
+#endif
 
 private:
     CustomDocument *m_textEdit;
@@ -114,11 +148,17 @@ private:
     QLineEdit *m_searchEdit;
 #if QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
     QWidget *m_kanbanWidget;
+    QVector<KanbanLine> m_taskIndex;
+    bool m_isTaskIndexValid;
+    KanbanColumnModel *m_kanbanColumnModel;
 #endif
     TagListView *m_tagListView;
     DBManager *m_dbManager;
     QVector<NodeData> m_currentNotes;
     bool m_isContentModified;
+    bool m_isDocumentDirty;
+    bool m_isContentStale;
+    int m_documentRevision;
     QTimer m_autoSaveTimer;
     TagListDelegate *m_tagListDelegate;
     TagListModel *m_tagListModel;
@@ -5,6 +5,7 @@
 #include <QApplication>
 #include <QtMath>
 #include <QPainterPath>
+#include <QStaticText>
 #include "notelistmodel.h"
 #include "noteeditorlogic.h"
 #include "tagpool.h"
@@ -12,6 +13,12 @@
 #include "fontloader.h"
 #include "utils.h"
 
+#define TAG_CHIP_HEIGHT 20
+#define TAG_CHIP_SPACING 3 // same as TagListView
+#define TAG_LIST_MAX_HEIGHT 80
+#define LABEL_LAYOUT_CACHE_SIZE 2000
+#define ROW_HEIGHT_CACHE_SIZE 20000
+
 NoteListDelegate::NoteListDelegate(NoteListView *view, TagPool *tagPool, QObject *parent)
     : QStyledItemDelegate(parent),
       m_view{ view },
@@ -63,6 +70,42 @@ NoteListDelegate::NoteListDelegate(NoteListView *view, TagPool *tagPool, QObject
         }
     });
 
+    if (m_view->model() != nullptr) {
+        connect(m_view->model(), &QAbstractItemModel::dataChanged, this,
+                [this](const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles) {
+            // content and scroll positions are not painted in the list, so
+            // edits that only touch them keep the cached layouts
+            bool affectsLayout = roles.isEmpty();
+            for (const auto role : roles) {
+                if (role != NoteListModel::NoteContent && role != NoteListModel::NoteScrollbarPos && role != NoteListModel::NoteTagListScrollbarPos
+                    && role != NoteListModel::NoteIsTemp) {
+                    affectsLayout = true;
+                    break;
+                }
+            }
+            if (!affectsLayout) {
+                return;
+            }
+            for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+                auto id = m_view->model()->index(row, 0).data(NoteListModel::NoteID).toInt();
+                m_labelLayoutCache.remove(id);
+                m_rowHeightCache.remove(id);
+            }
+        });
+        connect(m_view->model(), &QAbstractItemModel::modelReset, this, [this]() {
+            m_labelLayoutCache.clear();
+            m_rowHeightCache.clear();
+        });
+    }
+    connect(m_tagPool, &TagPool::dataReset, this, [this]() {
+        m_tagChipCache.clear();
+        m_rowHeightCache.clear();
+    });
+    connect(m_tagPool, &TagPool::dataUpdated, this, [this](int tagId) {
+        m_tagChipCache.remove(tagId);
+        m_rowHeightCache.clear();
+    });
+
     connect(m_timeLine, &QTimeLine::finished, this, [this]() {
         emit animationFinished(m_state);
         for (const auto &index : std::as_const(m_animatedIndexes)) {
@@ -84,7 +127,9 @@ NoteListDelegate::NoteListDelegate(NoteListView *view, TagPool *tagPool, QObject
             setStateI(a.second, indexes);
         } else {
             m_animatedIndexes.clear();
+            m_animationBuffers.clear();
             m_state = NoteListState::Normal;
+            m_view->updateUniformItemSizes();
         }
     });
 }
@@ -114,8 +159,8 @@ void NoteListDelegate::setAnimationDuration(const int duration)
 
 void NoteListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    bool isHaveTags = !index.data(NoteListModel::NoteTagsList).value<QSet<int>>().empty();
-    if ((!m_animatedIndexes.contains(index)) && isHaveTags) {
+    // rows with an open tag editor are painted by the editor itself
+    if ((!m_animatedIndexes.contains(index)) && m_view->isPersistentEditorOpen(index)) {
         return;
     }
     if (m_view->isPinnedNotesCollapsed()) {
@@ -153,16 +198,65 @@ void NoteListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
 
     paintBackground(painter, opt, index);
     paintLabels(painter, option, index);
+    if (!m_animatedIndexes.contains(index)) {
+        const auto *noteListModel = static_cast<NoteListModel *>(m_view->model());
+        const auto &note = noteListModel->getNote(index);
+        if (note.hasTags() && !(m_view->isPinnedNotesCollapsed() && note.isPinnedNote())) {
+            paintTagList(option.rect.y() + tagListTop(index), painter, option, index);
+        }
+    }
 }
 
+/*!
+ * \brief NoteListDelegate::sizeHint
+ * Row heights are cached per note together with everything they depend on
+ * besides the note itself (view width, pinned header position, collapse
+ * state), so a layout pass over a long list is mostly hash lookups.
+ * Animating rows and rows with an open editor are measured every time.
+ */
 QSize NoteListDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    auto const *noteListModel = static_cast<NoteListModel *>(m_view->model());
+    const auto &note = noteListModel->getNote(index);
+    if ((!m_animatedIndexes.isEmpty() && m_animatedIndexes.contains(index)) || m_sizeMap.contains(note.id())) {
+        return rowSizeHint(option, index);
+    }
+
+    const int width = m_view->viewport()->width();
+    const int flags = rowHeightFlags(index, note);
+    auto it = m_rowHeightCache.constFind(note.id());
+    if (it == m_rowHeightCache.constEnd() || it->width != width || it->flags != flags) {
+        if (m_rowHeightCache.size() > ROW_HEIGHT_CACHE_SIZE) {
+            m_rowHeightCache.clear();
+        }
+        RowHeight rowHeight{ rowSizeHint(option, index).height(), width, flags };
+        it = m_rowHeightCache.insert(note.id(), rowHeight);
+    }
+    return QSize(option.rect.width(), it->height);
+}
+
+int NoteListDelegate::rowHeightFlags(const QModelIndex &index, const NodeData &note) const
+{
+    auto const *noteListModel = static_cast<NoteListModel *>(m_view->model());
+    int flags = 0;
+    flags |= note.isPinnedNote() ? 0x01 : 0;
+    flags |= noteListModel->hasPinnedNote() ? 0x02 : 0;
+    flags |= noteListModel->isFirstPinnedNote(index) ? 0x04 : 0;
+    flags |= noteListModel->isFirstUnpinnedNote(index) ? 0x08 : 0;
+    flags |= m_view->isPinnedNotesCollapsed() ? 0x10 : 0;
+    flags |= m_isInAllNotes ? 0x20 : 0;
+    flags |= (index.row() > 0) ? 0x40 : 0;
+    return flags;
+}
+
+QSize NoteListDelegate::rowSizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
     QSize result; // = QStyledItemDelegate::sizeHint(option, index);
     result.setWidth(option.rect.width());
     auto const *noteListModel = static_cast<NoteListModel *>(m_view->model());
     const auto &note = noteListModel->getNote(index);
 
-    bool isHaveTags = !note.tagIds().empty();
+    bool isHaveTags = note.hasTags();
     if (m_view->isPersistentEditorOpen(index) && (!m_animatedIndexes.contains(index)) && isHaveTags) {
         auto id = note.id();
         if (m_sizeMap.contains(id)) {
@@ -172,7 +266,7 @@ QSize NoteListDelegate::sizeHint(const QStyleOptionViewItem &option, const QMode
     }
     int rowHeight = 70;
     if (isHaveTags) {
-        rowHeight = m_rowHeight;
+        rowHeight = 70 + tagListHeight(note.tagIdList(), m_view->viewport()->width() - 15) + 2;
     }
     if (m_animatedIndexes.contains(index)) {
         if (m_state == NoteListState::MoveIn) {
@@ -237,7 +331,7 @@ QSize NoteListDelegate::bufferSizeHint(const QStyleOptionViewItem &option, const
     QSize result = QStyledItemDelegate::sizeHint(option, index);
     result.setWidth(option.rect.width());
     auto id = index.data(NoteListModel::NoteID).toInt();
-    bool isHaveTags = !index.data(NoteListModel::NoteTagsList).value<QSet<int>>().empty();
+    bool isHaveTags = !index.data(NoteListModel::NoteTagsList).value<TagIdList>().isEmpty();
     if (m_view->isPersistentEditorOpen(index) && (!m_animatedIndexes.contains(index)) && isHaveTags) {
         if (m_sizeMap.contains(id)) {
             result.setHeight(m_sizeMap[id].height());
@@ -246,7 +340,8 @@ QSize NoteListDelegate::bufferSizeHint(const QStyleOptionViewItem &option, const
     }
     int rowHeight = 70;
     if (isHaveTags) {
-        rowHeight = m_rowHeight;
+        const auto &note = static_cast<NoteListModel *>(m_view->model())->getNote(index);
+        rowHeight = 70 + tagListHeight(note.tagIdList(), option.rect.width() - 15) + 2;
     }
     result.setHeight(rowHeight);
     if (m_isInAllNotes) {
@@ -294,152 +389,160 @@ QTimeLine::State NoteListDelegate::animationState()
 void NoteListDelegate::paintBackground(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
     auto bufferSize = bufferSizeHint(option, index);
-    QPixmap buffer{ bufferSize };
-    buffer.fill(Qt::transparent);
+    painter->setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+    if (!m_animatedIndexes.contains(index)) {
+        // paint in place, bottom-aligned and clipped to the row like the buffer it replaces
+        QRect backgroundRect(option.rect.x(), option.rect.bottom() - bufferSize.height() + 1, option.rect.width(), bufferSize.height());
+        painter->save();
+        painter->setClipRect(option.rect, Qt::IntersectClip);
+        fillBackground(painter, backgroundRect, option, index);
+        painter->restore();
+        return;
+    }
+
+    QPixmap &buffer = animationBuffer(bufferSize);
     QPainter bufferPainter{ &buffer };
     bufferPainter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
-    QRect bufferRect = buffer.rect();
+    fillBackground(&bufferPainter, buffer.rect(), option, index);
+    bufferPainter.end();
+    auto const *model = static_cast<NoteListModel *>(m_view->model());
+    int rowHeight;
+    if (m_state != NoteListState::MoveIn) {
+        double rowRate = m_timeLine->currentFrame() / (m_maxFrame * 1.0);
+        rowHeight = bufferSize.height() * rowRate;
+    } else {
+        double rowRate = 1.0 - (m_timeLine->currentFrame() / (m_maxFrame * 1.0));
+        rowHeight = bufferSize.height() * rowRate;
+    }
+
+    if (m_state == NoteListState::MoveIn) {
+        if (model->hasPinnedNote() && (model->isFirstPinnedNote(index) || model->isFirstUnpinnedNote(index))) {
+            painter->drawPixmap(QRect{ option.rect.x(), option.rect.y() + bufferSize.height() - rowHeight + 25, option.rect.width(), rowHeight }, buffer,
+                                QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
+        } else {
+            painter->drawPixmap(QRect{ option.rect.x(), option.rect.y() + bufferSize.height() - rowHeight, option.rect.width(), rowHeight }, buffer,
+                                QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
+        }
+    } else {
+        if (model->hasPinnedNote() && (model->isFirstPinnedNote(index) || model->isFirstUnpinnedNote(index))) {
+            painter->drawPixmap(QRect{ option.rect.x(), option.rect.y() + 25, option.rect.width(), option.rect.height() }, buffer,
+                                QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
+        } else {
+            painter->drawPixmap(option.rect, buffer, QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
+        }
+    }
+}
+
+void NoteListDelegate::fillBackground(QPainter *painter, const QRect &backgroundRect, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
     auto isPinned = index.data(NoteListModel::NoteIsPinned).toBool();
     auto const *model = static_cast<NoteListModel *>(m_view->model());
     if (model->hasPinnedNote() && model->isFirstPinnedNote(index) && static_cast<NoteListView *>(m_view)->isPinnedNotesCollapsed()) {
-        bufferPainter.fillRect(bufferRect, QBrush(m_defaultColor));
+        painter->fillRect(backgroundRect, QBrush(m_defaultColor));
     } else if ((option.state & QStyle::State_Selected) == QStyle::State_Selected) {
         if (qApp->applicationState() == Qt::ApplicationActive) {
             if (m_isActive) {
-                bufferPainter.fillRect(bufferRect, QBrush(m_activeColor));
+                painter->fillRect(backgroundRect, QBrush(m_activeColor));
             } else {
-                bufferPainter.fillRect(bufferRect, QBrush(m_notActiveColor));
+                painter->fillRect(backgroundRect, QBrush(m_notActiveColor));
             }
         } else if (qApp->applicationState() == Qt::ApplicationInactive) {
-            bufferPainter.fillRect(bufferRect, QBrush(m_applicationInactiveColor));
+            painter->fillRect(backgroundRect, QBrush(m_applicationInactiveColor));
         }
     } else if ((option.state & QStyle::State_MouseOver) == QStyle::State_MouseOver) {
         if (static_cast<NoteListView *>(m_view)->isDragging()) {
             if (isPinned) {
-                auto rect = bufferRect;
+                auto rect = backgroundRect;
                 rect.setTop(rect.bottom() - 5);
-                bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+                painter->fillRect(rect, QBrush("#d6d5d5"));
             }
         } else {
-            bufferPainter.fillRect(bufferRect, QBrush(m_hoverColor));
+            painter->fillRect(backgroundRect, QBrush(m_hoverColor));
         }
     } else {
         if (m_view->isPinnedNotesCollapsed()) {
             if (!isPinned) {
-                bufferPainter.fillRect(bufferRect, QBrush(m_defaultColor));
+                painter->fillRect(backgroundRect, QBrush(m_defaultColor));
             }
         } else {
-            bufferPainter.fillRect(bufferRect, QBrush(m_defaultColor));
+            painter->fillRect(backgroundRect, QBrush(m_defaultColor));
         }
     }
     if (static_cast<NoteListView *>(m_view)->isDragging() && !isPinned && !static_cast<NoteListView *>(m_view)->isDraggingInsidePinned()) {
         if (model->isFirstUnpinnedNote(index) && (index.row() == (model->rowCount() - 1))) {
-            auto rect = bufferRect;
+            auto rect = backgroundRect;
             rect.setHeight(4);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setWidth(3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setLeft(rect.right() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setTop(rect.bottom() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+            painter->fillRect(rect, QBrush("#d6d5d5"));
         } else if (model->isFirstUnpinnedNote(index)) {
-            auto rect = bufferRect;
+            auto rect = backgroundRect;
             rect.setHeight(4);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setWidth(3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setLeft(rect.right() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+            painter->fillRect(rect, QBrush("#d6d5d5"));
         } else if ((index.row() == (model->rowCount() - 1))) {
-            auto rect = bufferRect;
+            auto rect = backgroundRect;
             rect.setTop(rect.bottom() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setWidth(3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setLeft(rect.right() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+            painter->fillRect(rect, QBrush("#d6d5d5"));
         } else {
-            auto rect = bufferRect;
+            auto rect = backgroundRect;
             rect.setWidth(3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setLeft(rect.right() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+            painter->fillRect(rect, QBrush("#d6d5d5"));
         }
     }
 
     if (shouldPaintSeparator(index, *model)) {
-        paintSeparator(&bufferPainter, bufferRect, index);
-    }
-    int rowHeight;
-    if (m_animatedIndexes.contains(index)) {
-        if (m_state != NoteListState::MoveIn) {
-            double rowRate = m_timeLine->currentFrame() / (m_maxFrame * 1.0);
-            rowHeight = bufferSize.height() * rowRate;
-        } else {
-            double rowRate = 1.0 - (m_timeLine->currentFrame() / (m_maxFrame * 1.0));
-            rowHeight = bufferSize.height() * rowRate;
-        }
-    } else {
-        rowHeight = option.rect.height();
+        paintSeparator(painter, backgroundRect, index);
     }
-    painter->setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+}
 
-    if (m_animatedIndexes.contains(index)) {
-        if (m_state == NoteListState::MoveIn) {
-            if (model->hasPinnedNote() && (model->isFirstPinnedNote(index) || model->isFirstUnpinnedNote(index))) {
-                painter->drawPixmap(QRect{ option.rect.x(), option.rect.y() + bufferSize.height() - rowHeight + 25, option.rect.width(), rowHeight }, buffer,
-                                    QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
-            } else {
-                painter->drawPixmap(QRect{ option.rect.x(), option.rect.y() + bufferSize.height() - rowHeight, option.rect.width(), rowHeight }, buffer,
-                                    QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
-            }
-        } else {
-            if (model->hasPinnedNote() && (model->isFirstPinnedNote(index) || model->isFirstUnpinnedNote(index))) {
-                painter->drawPixmap(QRect{ option.rect.x(), option.rect.y() + 25, option.rect.width(), option.rect.height() }, buffer,
-                                    QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
-            } else {
-                painter->drawPixmap(option.rect, buffer, QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
-            }
-        }
-    } else {
-        painter->drawPixmap(option.rect, buffer, QRect{ 0, bufferSize.height() - rowHeight, option.rect.width(), rowHeight });
+/*!
+ * \brief NoteListDelegate::animationBuffer
+ * Returns a cleared off-screen buffer for a row that is being animated.
+ * Buffers are kept per size while the animation runs and freed when it ends.
+ */
+QPixmap &NoteListDelegate::animationBuffer(const QSize &size) const
+{
+    auto key = (static_cast<quint64>(static_cast<quint32>(size.width())) << 32) | static_cast<quint32>(size.height());
+    auto it = m_animationBuffers.find(key);
+    if (it == m_animationBuffers.end()) {
+        it = m_animationBuffers.insert(key, QPixmap(size));
     }
+    it->fill(Qt::transparent);
+    return it.value();
 }
 
 void NoteListDelegate::paintLabels(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
     if (m_animatedIndexes.contains(index)) {
         auto bufferSize = bufferSizeHint(option, index);
-        QPixmap buffer{ bufferSize };
-        buffer.fill(Qt::transparent);
+        QPixmap &buffer = animationBuffer(bufferSize);
         QPainter bufferPainter{ &buffer };
         bufferPainter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
-        QString title{ index.data(NoteListModel::NoteFullTitle).toString() };
-        QFont titleFont = (option.state & QStyle::State_Selected) == QStyle::State_Selected ? m_titleSelectedFont : m_titleFont;
-        QFontMetrics fmTitle(titleFont);
-        QRect fmRectTitle = fmTitle.boundingRect(title);
-
-        QString date = utils::parseDateTime(index.data(NoteListModel::NoteLastModificationDateTime).toDateTime());
-        QFontMetrics fmDate(m_dateFont);
-        QRect fmRectDate = fmDate.boundingRect(date);
-
-        QString parentName{ index.data(NoteListModel::NoteParentName).toString() };
-        QFontMetrics fmParentName(titleFont);
-        QRect fmRectParentName = fmParentName.boundingRect(parentName);
-
-        QString content{ index.data(NoteListModel::NoteContent).toString() };
-        content = NoteEditorLogic::getSecondLine(content);
-        QFontMetrics fmContent(titleFont);
-        QRect fmRectContent = fmContent.boundingRect(content);
+        bool isSelected = (option.state & QStyle::State_Selected) == QStyle::State_Selected;
+        QFont titleFont = isSelected ? m_titleSelectedFont : m_titleFont;
+        const auto &labels = labelLayout(index, titleFont, option.rect.width(), isSelected);
         double rowPosX = 0; // option.rect.x();
         double rowPosY = 0; // option.rect.y();
         auto const *noteListModel = static_cast<NoteListModel *>(m_view->model());
@@ -449,7 +552,6 @@ void NoteListDelegate::paintLabels(QPainter *painter, const QStyleOptionViewItem
                 return;
             }
         }
-        double rowWidth = option.rect.width();
         int secondYOffset = 0;
         if (index.row() > 0) {
             secondYOffset = note_list_constants::NEXT_NOTE_OFFSET;
@@ -471,48 +573,40 @@ void NoteListDelegate::paintLabels(QPainter *painter, const QStyleOptionViewItem
         int yOffsets = secondYOffset + thirdYOffset + fourthYOffset + fifthYOffset;
         double titleRectPosX = rowPosX + note_list_constants::LEFT_OFFSET_X;
         double titleRectPosY = rowPosY;
-        double titleRectWidth = rowWidth - (2.0 * note_list_constants::LEFT_OFFSET_X);
-        double titleRectHeight = fmRectTitle.height() + note_list_constants::TOP_OFFSET_Y + yOffsets;
+        double titleRectHeight = labels.titleHeight + note_list_constants::TOP_OFFSET_Y + yOffsets;
 
         double dateRectPosX = rowPosX + note_list_constants::LEFT_OFFSET_X;
-        double dateRectPosY = rowPosY + fmRectTitle.height() + note_list_constants::TOP_OFFSET_Y + yOffsets;
-        double dateRectWidth = rowWidth - (2.0 * note_list_constants::LEFT_OFFSET_X);
-        double dateRectHeight = fmRectDate.height() + note_list_constants::TITLE_DATE_SPACE;
+        double dateRectPosY = rowPosY + labels.titleHeight + note_list_constants::TOP_OFFSET_Y + yOffsets;
+        double dateRectHeight = labels.dateHeight + note_list_constants::TITLE_DATE_SPACE;
 
         double contentRectPosX = rowPosX + note_list_constants::LEFT_OFFSET_X;
-        double contentRectPosY = rowPosY + fmRectTitle.height() + fmRectDate.height() + note_list_constants::TOP_OFFSET_Y + yOffsets;
-        double contentRectWidth = rowWidth - (2.0 * note_list_constants::LEFT_OFFSET_X);
-        double contentRectHeight = fmRectContent.height() + note_list_constants::DATE_DESC_SPACE;
+        double contentRectPosY = rowPosY + labels.titleHeight + labels.dateHeight + note_list_constants::TOP_OFFSET_Y + yOffsets;
+        double contentRectHeight = labels.contentHeight + note_list_constants::DATE_DESC_SPACE;
 
         double folderNameRectPosX = 0;
         double folderNameRectPosY = 0;
-        double folderNameRectWidth = 0;
         double folderNameRectHeight = 0;
 
         if (m_isInAllNotes) {
             folderNameRectPosX = rowPosX + note_list_constants::LEFT_OFFSET_X + 20;
-            folderNameRectPosY = rowPosY + fmRectContent.height() + fmRectTitle.height() + fmRectDate.height() + note_list_constants::TOP_OFFSET_Y + yOffsets;
-            folderNameRectWidth = rowWidth - 2.0 * note_list_constants::LEFT_OFFSET_X;
-            folderNameRectHeight = fmRectParentName.height() + note_list_constants::DESC_FOLDER_SPACE;
+            folderNameRectPosY = rowPosY + labels.contentHeight + labels.titleHeight + labels.dateHeight + note_list_constants::TOP_OFFSET_Y + yOffsets;
+            folderNameRectHeight = labels.parentNameHeight + note_list_constants::DESC_FOLDER_SPACE;
         }
 
-        auto drawStr = [&bufferPainter](double posX, double posY, double width, double height, QColor color, const QFont &font, const QString &str) {
-            QRectF rect(posX, posY, width, height);
+        auto drawStr = [&bufferPainter](double posX, double posY, double height, QColor color, const QFont &font, const QStaticText &str) {
             bufferPainter.setPen(color);
             bufferPainter.setFont(font);
-            bufferPainter.drawText(rect, Qt::AlignBottom, str);
+            bufferPainter.drawStaticText(QPointF(posX, posY + height - str.size().height()), str);
         };
         // draw title & date
-        title = fmTitle.elidedText(title, Qt::ElideRight, int(titleRectWidth));
-        content = fmContent.elidedText(content, Qt::ElideRight, int(titleRectWidth));
-        drawStr(titleRectPosX, titleRectPosY, titleRectWidth, titleRectHeight, m_titleColor, titleFont, title);
-        drawStr(dateRectPosX, dateRectPosY, dateRectWidth, dateRectHeight, m_dateColor, m_dateFont, date);
+        drawStr(titleRectPosX, titleRectPosY, titleRectHeight, m_titleColor, titleFont, labels.title);
+        drawStr(dateRectPosX, dateRectPosY, dateRectHeight, m_dateColor, m_dateFont, labels.date);
         if (m_isInAllNotes) {
             bufferPainter.drawImage(QRect(rowPosX + note_list_constants::LEFT_OFFSET_X, folderNameRectPosY + note_list_constants::DESC_FOLDER_SPACE, 16, 16),
                                     m_folderIcon);
-            drawStr(folderNameRectPosX, folderNameRectPosY, folderNameRectWidth, folderNameRectHeight, m_contentColor, titleFont, parentName);
+            drawStr(folderNameRectPosX, folderNameRectPosY, folderNameRectHeight, m_contentColor, titleFont, labels.parentName);
         }
-        drawStr(contentRectPosX, contentRectPosY, contentRectWidth, contentRectHeight, m_contentColor, titleFont, content);
+        drawStr(contentRectPosX, contentRectPosY, contentRectHeight, m_contentColor, titleFont, labels.content);
         painter->setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
         int rowHeight;
         if (m_animatedIndexes.contains(index)) {
@@ -573,23 +667,9 @@ void NoteListDelegate::paintLabels(QPainter *painter, const QStyleOptionViewItem
             }
         }
     } else {
-        QString title{ index.data(NoteListModel::NoteFullTitle).toString() };
-        QFont titleFont = m_view->selectionModel()->isSelected(index) ? m_titleSelectedFont : m_titleFont;
-        QFontMetrics fmTitle(titleFont);
-        QRect fmRectTitle = fmTitle.boundingRect(title);
-
-        QString date = utils::parseDateTime(index.data(NoteListModel::NoteLastModificationDateTime).toDateTime());
-        QFontMetrics fmDate(m_dateFont);
-        QRect fmRectDate = fmDate.boundingRect(date);
-
-        QString parentName{ index.data(NoteListModel::NoteParentName).toString() };
-        QFontMetrics fmParentName(titleFont);
-        QRect fmRectParentName = fmParentName.boundingRect(parentName);
-
-        QString content{ index.data(NoteListModel::NoteContent).toString() };
-        content = NoteEditorLogic::getSecondLine(content);
-        QFontMetrics fmContent(titleFont);
-        QRect fmRectContent = fmContent.boundingRect(content);
+        bool isSelected = m_view->selectionModel()->isSelected(index);
+        QFont titleFont = isSelected ? m_titleSelectedFont : m_titleFont;
+        const auto &labels = labelLayout(index, titleFont, option.rect.width(), isSelected);
 
         double rowPosX = option.rect.x();
         double rowPosY = option.rect.y();
@@ -633,7 +713,6 @@ void NoteListDelegate::paintLabels(QPainter *painter, const QStyleOptionViewItem
                 return;
             }
         }
-        double rowWidth = option.rect.width();
         int secondYOffset = 0;
         if (index.row() > 0) {
             secondYOffset = note_list_constants::NEXT_NOTE_OFFSET;
@@ -651,49 +730,94 @@ void NoteListDelegate::paintLabels(QPainter *painter, const QStyleOptionViewItem
 
         double titleRectPosX = rowPosX + note_list_constants::LEFT_OFFSET_X;
         double titleRectPosY = rowPosY;
-        double titleRectWidth = rowWidth - (2.0 * note_list_constants::LEFT_OFFSET_X);
-        double titleRectHeight = fmRectTitle.height() + note_list_constants::TOP_OFFSET_Y + yOffsets;
+        double titleRectHeight = labels.titleHeight + note_list_constants::TOP_OFFSET_Y + yOffsets;
 
         double dateRectPosX = rowPosX + note_list_constants::LEFT_OFFSET_X;
-        double dateRectPosY = rowPosY + fmRectTitle.height() + note_list_constants::TOP_OFFSET_Y + yOffsets;
-        double dateRectWidth = rowWidth - (2.0 * note_list_constants::LEFT_OFFSET_X);
-        double dateRectHeight = fmRectDate.height() + note_list_constants::TITLE_DATE_SPACE;
+        double dateRectPosY = rowPosY + labels.titleHeight + note_list_constants::TOP_OFFSET_Y + yOffsets;
+        double dateRectHeight = labels.dateHeight + note_list_constants::TITLE_DATE_SPACE;
 
         double contentRectPosX = rowPosX + note_list_constants::LEFT_OFFSET_X;
-        double contentRectPosY = rowPosY + fmRectTitle.height() + fmRectDate.height() + note_list_constants::TOP_OFFSET_Y + yOffsets;
-        double contentRectWidth = rowWidth - (2.0 * note_list_constants::LEFT_OFFSET_X);
-        double contentRectHeight = fmRectContent.height() + note_list_constants::DATE_DESC_SPACE;
+        double contentRectPosY = rowPosY + labels.titleHeight + labels.dateHeight + note_list_constants::TOP_OFFSET_Y + yOffsets;
+        double contentRectHeight = labels.contentHeight + note_list_constants::DATE_DESC_SPACE;
 
         double folderNameRectPosX = 0;
         double folderNameRectPosY = 0;
-        double folderNameRectWidth = 0;
         double folderNameRectHeight = 0;
 
         if (isInAllNotes()) {
             folderNameRectPosX = rowPosX + note_list_constants::LEFT_OFFSET_X + 20;
-            folderNameRectPosY = rowPosY + fmRectContent.height() + fmRectTitle.height() + fmRectDate.height() + note_list_constants::TOP_OFFSET_Y + yOffsets;
-            folderNameRectWidth = rowWidth - 2.0 * note_list_constants::LEFT_OFFSET_X;
-            folderNameRectHeight = fmRectParentName.height() + note_list_constants::DESC_FOLDER_SPACE;
+            folderNameRectPosY = rowPosY + labels.contentHeight + labels.titleHeight + labels.dateHeight + note_list_constants::TOP_OFFSET_Y + yOffsets;
+            folderNameRectHeight = labels.parentNameHeight + note_list_constants::DESC_FOLDER_SPACE;
         }
-        auto drawStr = [painter](double posX, double posY, double width, double height, QColor color, const QFont &font, const QString &str) {
-            QRectF rect(posX, posY, width, height);
+        auto drawStr = [painter](double posX, double posY, double height, QColor color, const QFont &font, const QStaticText &str) {
             painter->setPen(color);
             painter->setFont(font);
-            painter->drawText(rect, Qt::AlignBottom, str);
+            painter->drawStaticText(QPointF(posX, posY + height - str.size().height()), str);
         };
 
         // draw title & date
-        title = fmTitle.elidedText(title, Qt::ElideRight, int(titleRectWidth));
-        content = fmContent.elidedText(content, Qt::ElideRight, int(titleRectWidth));
-        drawStr(titleRectPosX, titleRectPosY, titleRectWidth, titleRectHeight, m_titleColor, titleFont, title);
-        drawStr(dateRectPosX, dateRectPosY, dateRectWidth, dateRectHeight, m_dateColor, m_dateFont, date);
+        drawStr(titleRectPosX, titleRectPosY, titleRectHeight, m_titleColor, titleFont, labels.title);
+        drawStr(dateRectPosX, dateRectPosY, dateRectHeight, m_dateColor, m_dateFont, labels.date);
         if (isInAllNotes()) {
             painter->drawImage(QRect(rowPosX + note_list_constants::LEFT_OFFSET_X, folderNameRectPosY + note_list_constants::DESC_FOLDER_SPACE, 16, 16),
                                m_folderIcon);
-            drawStr(folderNameRectPosX, folderNameRectPosY, folderNameRectWidth, folderNameRectHeight, m_contentColor, titleFont, parentName);
+            drawStr(folderNameRectPosX, folderNameRectPosY, folderNameRectHeight, m_contentColor, titleFont, labels.parentName);
         }
-        drawStr(contentRectPosX, contentRectPosY, contentRectWidth, contentRectHeight, m_contentColor, titleFont, content);
+        drawStr(contentRectPosX, contentRectPosY, contentRectHeight, m_contentColor, titleFont, labels.content);
+    }
+}
+
+static QStaticText preparedText(const QString &text, const QFont &font)
+{
+    QStaticText staticText(text);
+    staticText.setTextFormat(Qt::PlainText);
+    staticText.setPerformanceHint(QStaticText::AggressiveCaching);
+    staticText.prepare(QTransform(), font);
+    return staticText;
+}
+
+/*!
+ * \brief NoteListDelegate::labelLayout
+ * Returns the elided, pre-laid-out labels of a row. Entries are keyed by note
+ * id and rebuilt when the row width, selection state or modification time
+ * changes; model data changes, theme changes and a new day (dates are shown
+ * relative to today) drop them.
+ */
+const NoteListDelegate::LabelLayout &NoteListDelegate::labelLayout(const QModelIndex &index, const QFont &titleFont, int width, bool isSelected) const
+{
+    const auto today = QDate::currentDate();
+    if (m_labelLayoutDate != today || m_labelLayoutCache.size() > LABEL_LAYOUT_CACHE_SIZE) {
+        m_labelLayoutCache.clear();
+        m_labelLayoutDate = today;
+    }
+    const auto &note = static_cast<NoteListModel *>(m_view->model())->getNote(index);
+    auto it = m_labelLayoutCache.constFind(note.id());
+    if (it != m_labelLayoutCache.constEnd() && it->width == width && it->isSelected == isSelected
+        && it->lastModificationTime == note.lastModificationTime()) {
+        return it.value();
     }
+
+    QString title{ index.data(NoteListModel::NoteFullTitle).toString() };
+    QString date = utils::parseDateTime(index.data(NoteListModel::NoteLastModificationDateTime).toDateTime());
+    QString parentName{ index.data(NoteListModel::NoteParentName).toString() };
+    QString content{ index.data(NoteListModel::NotePreview).toString() };
+    QFontMetrics fmTitle(titleFont);
+    QFontMetrics fmDate(m_dateFont);
+
+    LabelLayout layout;
+    layout.width = width;
+    layout.isSelected = isSelected;
+    layout.lastModificationTime = note.lastModificationTime();
+    layout.titleHeight = fmTitle.boundingRect(title).height();
+    layout.dateHeight = fmDate.boundingRect(date).height();
+    layout.parentNameHeight = fmTitle.boundingRect(parentName).height();
+    layout.contentHeight = fmTitle.boundingRect(content).height();
+    int elideWidth = int(width - (2.0 * note_list_constants::LEFT_OFFSET_X));
+    layout.title = preparedText(fmTitle.elidedText(title, Qt::ElideRight, elideWidth), titleFont);
+    layout.date = preparedText(date, m_dateFont);
+    layout.parentName = preparedText(parentName, titleFont);
+    layout.content = preparedText(fmTitle.elidedText(content, Qt::ElideRight, elideWidth), titleFont);
+    return m_labelLayoutCache.insert(note.id(), layout).value();
 }
 
 void NoteListDelegate::paintSeparator(QPainter *painter, QRect rect, const QModelIndex &index) const
@@ -708,51 +832,118 @@ void NoteListDelegate::paintSeparator(QPainter *painter, QRect rect, const QMode
     painter->drawLine(QPoint(posX1, posY), QPoint(posX2, posY));
 }
 
+/*!
+ * \brief NoteListDelegate::paintTagList
+ * Draws the tag chips of a row from cached pixmaps, laid out and scrolled the
+ * same way the TagListView of NoteListDelegateEditor shows them, so rows only
+ * need a real editor while they are hovered or selected.
+ */
 void NoteListDelegate::paintTagList(int top, QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    auto tagIds = index.data(NoteListModel::NoteTagsList).value<QSet<int>>();
-    int left = option.rect.x() + 10;
-
-    for (const auto &id : std::as_const(tagIds)) {
-        if (left >= option.rect.width()) {
-            break;
-        }
-        auto tag = m_tagPool->getTag(id);
-        QFontMetrics fmName(m_titleFont);
-        QRect fmRectName = fmName.boundingRect(tag.name());
-
-        auto rect = option.rect;
-        rect.setTop(top);
-        rect.setLeft(left);
-        rect.setHeight(20);
-        rect.setWidth(5 + 12 + 5 + fmRectName.width() + 7);
-        left += rect.width() + 5;
-        QPainterPath path;
-        path.addRoundedRect(rect, 10, 10);
-        if (m_theme == Theme::Dark) {
-            painter->fillPath(path, QColor(76, 85, 97));
-        } else if ((option.state & QStyle::State_Selected) == QStyle::State_Selected) {
-            painter->fillPath(path, QColor(218, 235, 248));
-        } else {
-            painter->fillPath(path, QColor(227, 234, 243));
+    const auto &note = static_cast<NoteListModel *>(m_view->model())->getNote(index);
+    QRect listRect(option.rect.x() + note_list_constants::LEFT_OFFSET_X - 5, top, option.rect.width() - 15, 0);
+    listRect.setHeight(tagListHeight(note.tagIdList(), listRect.width()));
+
+    painter->save();
+    painter->setClipRect(listRect);
+    painter->translate(listRect.x(), listRect.y() - note.tagListScrollBarPos());
+    for (const auto &chip : tagChipLayout(note.tagIdList(), listRect.width())) {
+        painter->drawPixmap(chip.second.topLeft(), tagChipPixmap(chip.first));
+    }
+    painter->restore();
+}
+
+QVector<QPair<int, QRect>> NoteListDelegate::tagChipLayout(const TagIdList &tagIds, int width) const
+{
+    QVector<QPair<int, QRect>> result;
+    int x = TAG_CHIP_SPACING;
+    int y = TAG_CHIP_SPACING;
+    for (const auto tagId : tagIds) {
+        if (!m_tagPool->contains(tagId)) {
+            continue;
+        }
+        const auto &chip = tagChipPixmap(tagId);
+        QSize chipSize = (QSizeF(chip.size()) / chip.devicePixelRatio()).toSize();
+        if ((x > TAG_CHIP_SPACING) && (x + chipSize.width() > width)) {
+            x = TAG_CHIP_SPACING;
+            y += TAG_CHIP_HEIGHT + TAG_CHIP_SPACING;
         }
-        auto iconRect = QRect(rect.x() + 5, rect.y() + ((rect.height() - 12) / 2), 14, 14);
-        painter->setPen(QColor(tag.color()));
+        result.append(qMakePair(tagId, QRect(QPoint(x, y), chipSize)));
+        x += chipSize.width() + TAG_CHIP_SPACING;
+    }
+    return result;
+}
+
+int NoteListDelegate::tagListHeight(const TagIdList &tagIds, int width) const
+{
+    auto layout = tagChipLayout(tagIds, width);
+    if (layout.isEmpty()) {
+        return 0;
+    }
+    int height = layout.last().second.bottom() - layout.first().second.top() + 1;
+    return qMin(height + 10, TAG_LIST_MAX_HEIGHT);
+}
+
+int NoteListDelegate::tagListTop(const QModelIndex &index) const
+{
+    auto const *noteListModel = static_cast<NoteListModel *>(m_view->model());
+    int y = m_isInAllNotes ? 90 : 70;
+    if (noteListModel->hasPinnedNote() && (noteListModel->isFirstPinnedNote(index) || noteListModel->isFirstUnpinnedNote(index))) {
+        y += 25;
+    }
+    if (noteListModel->isFirstUnpinnedNote(index)) {
+        y += note_list_constants::UNPINNED_HEADER_TO_NOTE_SPACE;
+    }
+    if (noteListModel->hasPinnedNote() && !m_view->isPinnedNotesCollapsed() && noteListModel->isFirstUnpinnedNote(index)) {
+        y += note_list_constants::LAST_PINNED_TO_UNPINNED_HEADER;
+    }
+    if (m_isInAllNotes) {
+        y += 5;
+    }
+    return y;
+}
+
+const QPixmap &NoteListDelegate::tagChipPixmap(int tagId) const
+{
+    auto it = m_tagChipCache.constFind(tagId);
+    if (it != m_tagChipCache.constEnd()) {
+        return it.value();
+    }
+    auto tag = m_tagPool->getTag(tagId);
+    QFontMetrics fmName(m_titleFont);
+    QRect fmRectName = fmName.boundingRect(tag.name());
+    QRect rect(0, 0, 5 + 12 + 5 + fmRectName.width() + 7, TAG_CHIP_HEIGHT);
+
+    const qreal dpr = m_view->devicePixelRatioF();
+    QPixmap chip(rect.size() * dpr);
+    chip.setDevicePixelRatio(dpr);
+    chip.fill(Qt::transparent);
+    QPainter painter(&chip);
+    painter.setRenderHint(QPainter::Antialiasing);
+    QPainterPath path;
+    path.addRoundedRect(rect, 10, 10);
+    if (m_theme == Theme::Dark) {
+        painter.fillPath(path, QColor(76, 85, 97));
+    } else {
+        painter.fillPath(path, QColor(218, 235, 248));
+    }
+    auto iconRect = QRect(rect.x() + 5, rect.y() + ((rect.height() - 12) / 2), 12, 12);
+    painter.setPen(QColor(tag.color()));
 #ifdef __APPLE__
-        int iconPointSizeOffset = 0;
+    int iconPointSizeOffset = 0;
 #else
-        int iconPointSizeOffset = -4;
+    int iconPointSizeOffset = -4;
 #endif
-        painter->setFont(font_loader::loadFont("Font Awesome 6 Free Solid", "", 14 + iconPointSizeOffset));
-        painter->drawText(iconRect, u8"\uf111"); // fa-circle
-        painter->setBrush(m_titleColor);
-        painter->setPen(m_titleColor);
-
-        QRect nameRect(rect);
-        nameRect.setLeft(iconRect.x() + iconRect.width() + 5);
-        painter->setFont(m_titleFont);
-        painter->drawText(nameRect, Qt::AlignLeft | Qt::AlignVCenter, tag.name());
-    }
+    painter.setFont(font_loader::loadFont("Font Awesome 6 Free Solid", "", 12 + iconPointSizeOffset));
+    painter.drawText(iconRect, u8"\uf111"); // fa-circle
+    painter.setPen(m_titleColor);
+
+    QRect nameRect(rect);
+    nameRect.setLeft(iconRect.x() + iconRect.width() + 5);
+    painter.setFont(m_titleFont);
+    painter.drawText(nameRect, Qt::AlignLeft | Qt::AlignVCenter, tag.name());
+    painter.end();
+    return m_tagChipCache.insert(tagId, chip).value();
 }
 
 bool NoteListDelegate::shouldPaintSeparator(const QModelIndex &index, const NoteListModel &model) const
@@ -797,6 +988,8 @@ void NoteListDelegate::setStateI(NoteListState NewState, const QModelIndexList &
         for (const auto &index : std::as_const(m_animatedIndexes)) {
             m_view->closePersistentEditorC(index);
         }
+        // animated rows change height every frame
+        m_view->setUniformItemSizes(false);
         m_timeLine->setDirection(diretion);
         m_timeLine->setDuration(duration);
         m_timeLine->start();
@@ -874,7 +1067,7 @@ QWidget *NoteListDelegate::createEditor(QWidget *parent, const QStyleOptionViewI
             }
         }
     }
-    bool isHaveTags = !index.data(NoteListModel::NoteTagsList).value<QSet<int>>().empty();
+    bool isHaveTags = !index.data(NoteListModel::NoteTagsList).value<TagIdList>().isEmpty();
     if (!isHaveTags) {
         return nullptr;
     }
@@ -943,5 +1136,8 @@ void NoteListDelegate::setTheme(Theme::Value theme)
         break;
     }
     }
+    m_tagChipCache.clear();
+    m_labelLayoutCache.clear();
+    m_rowHeightCache.clear();
     emit themeChanged(m_theme);
 }
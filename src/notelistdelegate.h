@@ -5,6 +5,7 @@
 #include <QStyledItemDelegate>
 #include <QTimeLine>
 #include <QQueue>
+#include <QStaticText>
 #include "editorsettingsoptions.h"
 
 class TagPool;
@@ -53,10 +54,40 @@ signals:
     void animationFinished(NoteListState animationState);
 
 private:
+    struct LabelLayout
+    {
+        int width = 0;
+        bool isSelected = false;
+        qint64 lastModificationTime = INVALID_TIME;
+        QStaticText title;
+        QStaticText date;
+        QStaticText parentName;
+        QStaticText content;
+        int titleHeight = 0;
+        int dateHeight = 0;
+        int parentNameHeight = 0;
+        int contentHeight = 0;
+    };
+    struct RowHeight
+    {
+        int height;
+        int width;
+        int flags;
+    };
+
     void paintBackground(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    QSize rowSizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    int rowHeightFlags(const QModelIndex &index, const NodeData &note) const;
+    void fillBackground(QPainter *painter, const QRect &backgroundRect, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    QPixmap &animationBuffer(const QSize &size) const;
     void paintLabels(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
     void paintSeparator(QPainter *painter, QRect rect, const QModelIndex &index) const;
     void paintTagList(int top, QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
+    QVector<QPair<int, QRect>> tagChipLayout(const TagIdList &tagIds, int width) const;
+    int tagListHeight(const TagIdList &tagIds, int width) const;
+    int tagListTop(const QModelIndex &index) const;
+    const QPixmap &tagChipPixmap(int tagId) const;
+    const LabelLayout &labelLayout(const QModelIndex &index, const QFont &titleFont, int width, bool isSelected) const;
     void setStateI(NoteListState NewState, const QModelIndexList &indexes);
 
     NoteListView *m_view;
@@ -87,6 +118,11 @@ private:
     QModelIndexList m_animatedIndexes;
     QModelIndex m_hoveredIndex;
     QMap<int, QSize> m_sizeMap;
+    mutable QHash<int, QPixmap> m_tagChipCache;
+    mutable QHash<int, LabelLayout> m_labelLayoutCache;
+    mutable QHash<quint64, QPixmap> m_animationBuffers;
+    mutable QHash<int, RowHeight> m_rowHeightCache;
+    mutable QDate m_labelLayoutDate;
     QQueue<QPair<QSet<int>, NoteListState>> m_animationQueue;
 };
 
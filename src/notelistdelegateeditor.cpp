@@ -70,7 +70,8 @@ NoteListDelegateEditor::NoteListDelegateEditor(const NoteListDelegate *delegate,
     m_tagListView->setModel(m_tagListModel);
     m_tagListView->setItemDelegate(m_tagListDelegate);
     m_tagListModel->setTagPool(tagPool);
-    m_tagListModel->setModelData(index.data(NoteListModel::NoteTagsList).value<QSet<int>>());
+    auto tagIds = index.data(NoteListModel::NoteTagsList).value<TagIdList>();
+    m_tagListModel->setModelData(QSet<int>(tagIds.cbegin(), tagIds.cend()));
     if (m_delegate->isInAllNotes()) {
         int y = 90;
         auto const *noteListModel = static_cast<NoteListModel *>(m_view->model());
@@ -134,98 +135,91 @@ NoteListDelegateEditor::~NoteListDelegateEditor()
 
 void NoteListDelegateEditor::paintBackground(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    auto bufferSize = rect().size();
-    QPixmap buffer{ bufferSize };
-    buffer.fill(Qt::transparent);
-    QPainter bufferPainter{ &buffer };
-    bufferPainter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
-    QRect bufferRect = buffer.rect();
+    painter->setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+    QRect backgroundRect = rect();
     auto const *noteListModel = static_cast<NoteListModel *>(m_view->model());
     if (noteListModel->hasPinnedNote() && (noteListModel->isFirstPinnedNote(index) || noteListModel->isFirstUnpinnedNote(index))) {
         int fifthYOffset = 0;
         if (!m_view->isPinnedNotesCollapsed() && noteListModel->isFirstUnpinnedNote(index)) {
             fifthYOffset = note_list_constants::LAST_PINNED_TO_UNPINNED_HEADER;
         }
-        bufferRect.setY(bufferRect.y() + 25 + fifthYOffset);
+        backgroundRect.setY(backgroundRect.y() + 25 + fifthYOffset);
     }
     auto isPinned = index.data(NoteListModel::NoteIsPinned).toBool();
     if (m_view->selectionModel()->isSelected(index)) {
         if (qApp->applicationState() == Qt::ApplicationActive) {
             if (m_isActive) {
-                bufferPainter.fillRect(bufferRect, QBrush(m_activeColor));
+                painter->fillRect(backgroundRect, QBrush(m_activeColor));
                 m_tagListView->setBackground(m_activeColor);
             } else {
-                bufferPainter.fillRect(bufferRect, QBrush(m_notActiveColor));
+                painter->fillRect(backgroundRect, QBrush(m_notActiveColor));
                 m_tagListView->setBackground(m_notActiveColor);
             }
         } else if (qApp->applicationState() == Qt::ApplicationInactive) {
-            bufferPainter.fillRect(bufferRect, QBrush(m_applicationInactiveColor));
+            painter->fillRect(backgroundRect, QBrush(m_applicationInactiveColor));
             m_tagListView->setBackground(m_applicationInactiveColor);
         }
     } else if (underMouseC()) {
         if (m_view->isDragging()) {
             if (isPinned) {
-                auto rect = bufferRect;
+                auto rect = backgroundRect;
                 rect.setTop(rect.bottom() - 5);
-                bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+                painter->fillRect(rect, QBrush("#d6d5d5"));
             }
         } else {
-            bufferPainter.fillRect(bufferRect, QBrush(m_hoverColor));
+            painter->fillRect(backgroundRect, QBrush(m_hoverColor));
             m_tagListView->setBackground(m_hoverColor);
         }
     } else {
-        bufferPainter.fillRect(bufferRect, QBrush(m_defaultColor));
+        painter->fillRect(backgroundRect, QBrush(m_defaultColor));
         m_tagListView->setBackground(m_defaultColor);
     }
     if (m_view->isDragging() && !isPinned && !m_view->isDraggingInsidePinned()) {
         if ((noteListModel != nullptr) && noteListModel->isFirstUnpinnedNote(index) && (index.row() == (noteListModel->rowCount() - 1))) {
-            auto rect = bufferRect;
+            auto rect = backgroundRect;
             rect.setHeight(4);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setWidth(3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setLeft(rect.right() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setTop(rect.bottom() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+            painter->fillRect(rect, QBrush("#d6d5d5"));
         } else if ((noteListModel != nullptr) && noteListModel->isFirstUnpinnedNote(index)) {
-            auto rect = bufferRect;
+            auto rect = backgroundRect;
             rect.setHeight(4);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setWidth(3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setLeft(rect.right() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+            painter->fillRect(rect, QBrush("#d6d5d5"));
         } else if ((noteListModel != nullptr) && (index.row() == (noteListModel->rowCount() - 1))) {
-            auto rect = bufferRect;
+            auto rect = backgroundRect;
             rect.setTop(rect.bottom() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setWidth(3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setLeft(rect.right() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+            painter->fillRect(rect, QBrush("#d6d5d5"));
         } else {
-            auto rect = bufferRect;
+            auto rect = backgroundRect;
             rect.setWidth(3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
-            rect = bufferRect;
+            painter->fillRect(rect, QBrush("#d6d5d5"));
+            rect = backgroundRect;
             rect.setLeft(rect.right() - 3);
-            bufferPainter.fillRect(rect, QBrush("#d6d5d5"));
+            painter->fillRect(rect, QBrush("#d6d5d5"));
         }
     }
     if ((noteListModel != nullptr) && (m_delegate != nullptr) && m_delegate->shouldPaintSeparator(index, *noteListModel)) {
-        paintSeparator(&bufferPainter, option, index);
+        paintSeparator(painter, option, index);
     }
-
-    auto rowHeight = rect().height();
-    painter->drawPixmap(rect(), buffer, QRect{ 0, bufferSize.height() - rowHeight, rect().width(), rowHeight });
 }
 
 void NoteListDelegateEditor::paintLabels(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
@@ -245,8 +239,7 @@ void NoteListDelegateEditor::paintLabels(QPainter *painter, const QStyleOptionVi
     QFontMetrics fmParentName(titleFont);
     QRect fmRectParentName = fmParentName.boundingRect(parentName);
 
-    QString content{ index.data(NoteListModel::NoteContent).toString() };
-    content = NoteEditorLogic::getSecondLine(content);
+    QString content{ index.data(NoteListModel::NotePreview).toString() };
     QFontMetrics fmContent(titleFont);
     QRect fmRectContent = fmContent.boundingRect(content);
 
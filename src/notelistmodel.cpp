@@ -3,6 +3,10 @@
 #include "nodepath.h"
 #include <QTimer>
 #include <QMimeData>
+#include <algorithm>
+#include <functional>
+
+#define LIST_DIFF_MAX_OPERATIONS 256
 
 NoteListModel::NoteListModel(QObject *parent) : QAbstractListModel(parent), m_listViewInfo() { }
 
@@ -12,6 +16,7 @@ QModelIndex NoteListModel::addNote(const NodeData &note)
         const int rowCnt = rowCount();
         beginInsertRows(QModelIndex(), rowCnt, rowCnt);
         m_noteList << note;
+        m_idToRow.insert(note.id(), rowCnt);
         endInsertRows();
         emit rowsInsertedC({ createIndex(rowCnt, 0) });
         emit rowCountChanged();
@@ -20,6 +25,7 @@ QModelIndex NoteListModel::addNote(const NodeData &note)
     const int rowCnt = m_pinnedList.size();
     beginInsertRows(QModelIndex(), rowCnt, rowCnt);
     m_pinnedList << note;
+    updateIdIndex(rowCnt, rowCount() - 1);
     endInsertRows();
     emit rowsInsertedC({ createIndex(rowCnt, 0) });
     emit rowCountChanged();
@@ -36,6 +42,7 @@ QModelIndex NoteListModel::insertNote(const NodeData &note, int row)
         }
         beginInsertRows(QModelIndex(), row, row);
         m_pinnedList.insert(row, note);
+        updateIdIndex(row, rowCount() - 1);
         endInsertRows();
         emit rowsInsertedC({ createIndex(row, 0) });
         emit rowCountChanged();
@@ -48,6 +55,7 @@ QModelIndex NoteListModel::insertNote(const NodeData &note, int row)
     }
     beginInsertRows(QModelIndex(), row, row);
     m_noteList.insert(row - m_pinnedList.size(), note);
+    updateIdIndex(row, rowCount() - 1);
     endInsertRows();
     emit rowsInsertedC({ createIndex(row, 0) });
     emit rowCountChanged();
@@ -66,47 +74,233 @@ const NodeData &NoteListModel::getNote(const QModelIndex &index) const
 
 QModelIndex NoteListModel::getNoteIndex(int id) const
 {
-    for (int i = 0; i < m_pinnedList.size(); ++i) {
-        if (m_pinnedList[i].id() == id) {
-            return createIndex(i, 0);
-        }
+    auto it = m_idToRow.constFind(id);
+    if (it == m_idToRow.constEnd()) {
+        return QModelIndex{};
     }
-
-    for (int i = 0; i < m_noteList.size(); ++i) {
-        if (m_noteList[i].id() == id) {
-            return createIndex(i + m_pinnedList.size(), 0);
-        }
-    }
-    return QModelIndex{};
+    Q_ASSERT(getRef(it.value()).id() == id);
+    return createIndex(it.value(), 0);
 }
 
 void NoteListModel::setListNote(const QVector<NodeData> &notes, const ListViewInfo &inf)
 {
-    beginResetModel();
-    m_pinnedList.clear();
-    m_noteList.clear();
     m_listViewInfo = inf;
+    QVector<NodeData> pinnedList;
+    QVector<NodeData> noteList;
     if ((!m_listViewInfo.isInTag) && (m_listViewInfo.parentFolderId != TRASH_FOLDER_ID)) {
         for (const auto &note : std::as_const(notes)) {
             if (note.isPinnedNote()) {
-                m_pinnedList.append(note);
+                pinnedList.append(note);
             } else {
-                m_noteList.append(note);
+                noteList.append(note);
             }
         }
     } else {
-        m_noteList = notes;
+        noteList = notes;
+    }
+    sortNoteList(pinnedList, noteList);
+
+    const int oldRowCount = rowCount();
+    int survivors = 0;
+    for (const auto &note : std::as_const(notes)) {
+        if (m_idToRow.contains(note.id())) {
+            ++survivors;
+        }
+    }
+    if (oldRowCount > 0 && survivors * 2 >= notes.size()) {
+        int budget = LIST_DIFF_MAX_OPERATIONS;
+        bool structureChanged = false;
+        // both sections drop their stale rows before either inserts, a note
+        // that changed pin state must leave its old section first or the id
+        // index would still point at its old row
+        if (removeStaleRows(m_pinnedList, 0, pinnedList, budget, structureChanged)
+            && removeStaleRows(m_noteList, m_pinnedList.size(), noteList, budget, structureChanged)
+            && diffNoteSection(m_pinnedList, 0, pinnedList, budget, structureChanged)
+            && diffNoteSection(m_noteList, m_pinnedList.size(), noteList, budget, structureChanged)) {
+            if (structureChanged || rowCount() != oldRowCount) {
+                emit rowCountChanged();
+            }
+            return;
+        }
     }
-    sort(0, Qt::AscendingOrder);
+
+    beginResetModel();
+    m_pinnedList = pinnedList;
+    m_noteList = noteList;
+    rebuildIdIndex();
     endResetModel();
     emit rowCountChanged();
 }
 
+/*!
+ * \brief NoteListModel::removeStaleRows
+ * First step of the list diff: removes the rows of section (the pinned or
+ * unpinned part of the list, starting at row offset) whose note isn't in
+ * target, in contiguous ranges. Returns false once budget is exhausted.
+ */
+bool NoteListModel::removeStaleRows(QVector<NodeData> &section, int offset, const QVector<NodeData> &target, int &budget, bool &structureChanged)
+{
+    QSet<int> targetIds;
+    targetIds.reserve(target.size());
+    for (const auto &note : target) {
+        targetIds.insert(note.id());
+    }
+
+    int row = section.size() - 1;
+    while (row >= 0) {
+        if (targetIds.contains(section[row].id())) {
+            --row;
+            continue;
+        }
+        int first = row;
+        while (first > 0 && !targetIds.contains(section[first - 1].id())) {
+            --first;
+        }
+        if (--budget < 0) {
+            return false;
+        }
+        beginRemoveRows(QModelIndex(), offset + first, offset + row);
+        for (int r = first; r <= row; ++r) {
+            m_idToRow.remove(section[r].id());
+        }
+        section.remove(first, row - first + 1);
+        updateIdIndex(offset + first, rowCount() - 1);
+        endRemoveRows();
+        structureChanged = true;
+        row = first - 1;
+    }
+    return true;
+}
+
+/*!
+ * \brief NoteListModel::diffNoteSection
+ * Turns section, already stripped by removeStaleRows, into target with row
+ * moves and insertions keyed by note id, so the view keeps its selection,
+ * scroll position and editors. Returns false once more than budget row
+ * operations would be needed; the caller then resets the model instead.
+ * The id index is updated before each operation is reported, so slots on
+ * those signals can use getNoteIndex.
+ */
+bool NoteListModel::diffNoteSection(QVector<NodeData> &section, int offset, const QVector<NodeData> &target, int &budget, bool &structureChanged)
+{
+    for (int i = 0; i < target.size(); ++i) {
+        const auto &note = target[i];
+        if (i < section.size() && section[i].id() == note.id()) {
+            if (!isSameListEntry(section[i], note)) {
+                section[i] = note;
+                emit dataChanged(index(offset + i), index(offset + i));
+            }
+            continue;
+        }
+        if (--budget < 0) {
+            return false;
+        }
+        int from = -1;
+        for (int j = i + 1; j < section.size(); ++j) {
+            if (section[j].id() == note.id()) {
+                from = j;
+                break;
+            }
+        }
+        if (from != -1) {
+            beginMoveRows(QModelIndex(), offset + from, offset + from, QModelIndex(), offset + i);
+            section.move(from, i);
+            section[i] = note;
+            updateIdIndex(offset + i, offset + from);
+            endMoveRows();
+            emit dataChanged(index(offset + i), index(offset + i));
+        } else {
+            beginInsertRows(QModelIndex(), offset + i, offset + i);
+            section.insert(i, note);
+            updateIdIndex(offset + i, rowCount() - 1);
+            endInsertRows();
+            structureChanged = true;
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief NoteListModel::isSameListEntry
+ * True when a row showing lhs would paint exactly the same for rhs
+ */
+bool NoteListModel::isSameListEntry(const NodeData &lhs, const NodeData &rhs)
+{
+    return lhs.id() == rhs.id() && lhs.lastModificationTime() == rhs.lastModificationTime() && lhs.deletionTime() == rhs.deletionTime()
+            && lhs.fullTitle() == rhs.fullTitle() && lhs.displayTitle() == rhs.displayTitle() && lhs.preview() == rhs.preview()
+            && lhs.parentName() == rhs.parentName() && lhs.isPinnedNote() == rhs.isPinnedNote() && lhs.tagIdList() == rhs.tagIdList();
+}
+
+/*!
+ * \brief NoteListModel::rebuildIdIndex
+ * Recomputes the whole id -> row index, used after resets and sorting
+ */
+void NoteListModel::rebuildIdIndex()
+{
+    m_idToRow.clear();
+    m_idToRow.reserve(rowCount());
+    updateIdIndex(0, rowCount() - 1);
+}
+
+/*!
+ * \brief NoteListModel::updateIdIndex
+ * Re-records the rows in [fromRow, toRow] after notes in that range shifted
+ */
+void NoteListModel::updateIdIndex(int fromRow, int toRow)
+{
+    for (int row = fromRow; row <= toRow; ++row) {
+        m_idToRow[getRef(row).id()] = row;
+    }
+}
+
 void NoteListModel::removeNotes(const QModelIndexList &noteIndexes)
 {
     emit requestRemoveNotes(noteIndexes);
 }
 
+/*!
+ * \brief NoteListModel::removeNotesById
+ * Removes the given notes in contiguous row ranges, bottom-up, and emits
+ * rowCountChanged once for the whole batch
+ */
+void NoteListModel::removeNotesById(const QVector<int> &noteIds)
+{
+    QVector<int> rows;
+    rows.reserve(noteIds.size());
+    for (const auto id : noteIds) {
+        auto it = m_idToRow.constFind(id);
+        if (it != m_idToRow.constEnd()) {
+            rows.append(it.value());
+        }
+    }
+    if (rows.isEmpty()) {
+        return;
+    }
+    std::sort(rows.begin(), rows.end(), std::greater<int>());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    for (int i = 0; i < rows.size();) {
+        int last = rows[i];
+        int first = last;
+        int j = i + 1;
+        while (j < rows.size() && rows[j] == first - 1) {
+            first = rows[j];
+            ++j;
+        }
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int row = last; row >= first; --row) {
+            if (row < m_pinnedList.size()) {
+                m_idToRow.remove(m_pinnedList.takeAt(row).id());
+            } else {
+                m_idToRow.remove(m_noteList.takeAt(row - m_pinnedList.size()).id());
+            }
+        }
+        updateIdIndex(first, rowCount() - 1);
+        endRemoveRows();
+        i = j;
+    }
+    emit rowCountChanged();
+}
+
 bool NoteListModel::moveRow(const QModelIndex &sourceParent, int sourceRow, const QModelIndex &destinationParent, int destinationChild)
 {
     if (sourceRow < 0 || sourceRow >= rowCount() || destinationChild < 0 || destinationChild >= rowCount()) {
@@ -115,6 +309,7 @@ bool NoteListModel::moveRow(const QModelIndex &sourceParent, int sourceRow, cons
     if (sourceRow < m_pinnedList.size() && destinationChild < m_pinnedList.size()) {
         if (beginMoveRows(sourceParent, sourceRow, sourceRow, destinationParent, destinationChild)) {
             m_pinnedList.move(sourceRow, destinationChild);
+            updateIdIndex(std::min(sourceRow, destinationChild), std::max(sourceRow, destinationChild));
             endMoveRows();
             emit rowsAboutToBeMovedC({ createIndex(sourceRow, 0) });
             emit rowsMovedC({ createIndex(destinationChild, 0) });
@@ -127,6 +322,7 @@ bool NoteListModel::moveRow(const QModelIndex &sourceParent, int sourceRow, cons
         destinationChild = destinationChild - m_pinnedList.size();
         if (beginMoveRows(sourceParent, sourceRow, sourceRow, destinationParent, destinationChild)) {
             m_noteList.move(sourceRow, destinationChild);
+            updateIdIndex(std::min(sourceRow, destinationChild) + m_pinnedList.size(), std::max(sourceRow, destinationChild) + m_pinnedList.size());
             endMoveRows();
             emit rowsAboutToBeMovedC({ createIndex(sourceRow, 0) });
             emit rowsMovedC({ createIndex(destinationChild + 1, 0) });
@@ -142,6 +338,7 @@ void NoteListModel::clearNotes()
     beginResetModel();
     m_pinnedList.clear();
     m_noteList.clear();
+    m_idToRow.clear();
     endResetModel();
     emit rowCountChanged();
 }
@@ -151,7 +348,7 @@ QVariant NoteListModel::data(const QModelIndex &index, int role) const
     if (index.row() < 0 || index.row() >= (m_noteList.count() + m_pinnedList.count())) {
         return {};
     }
-    if (role < NoteID || role > NoteIsPinned) {
+    if (role < NoteID || role > NotePreview) {
         return {};
     }
     const NodeData &note = getRef(index.row());
@@ -160,12 +357,10 @@ QVariant NoteListModel::data(const QModelIndex &index, int role) const
     case NoteID:
         return note.id();
     case NoteFullTitle: {
-        auto text = note.fullTitle().trimmed();
-        if (text.startsWith("#")) {
-            text.remove(0, 1);
-            text = text.trimmed();
+        if (note.displayTitle().isNull()) {
+            return NodeData::getDisplayTitle(note.fullTitle());
         }
-        return text;
+        return note.displayTitle();
     }
     case NoteCreationDateTime:
         return note.creationDateTime();
@@ -174,11 +369,16 @@ QVariant NoteListModel::data(const QModelIndex &index, int role) const
     case NoteDeletionDateTime:
         return note.deletionDateTime();
     case NoteContent:
+        // list rows only carry the preview, an invalid value tells an unloaded
+        // body apart from an empty one
+        if (!note.isContentLoaded()) {
+            return {};
+        }
         return note.content();
     case NoteScrollbarPos:
         return note.scrollBarPosition();
     case NoteTagsList:
-        return QVariant::fromValue(note.tagIds());
+        return QVariant::fromValue(note.tagIdList());
     case NoteIsTemp:
         return note.isTempNote();
     case NoteParentName:
@@ -187,6 +387,8 @@ QVariant NoteListModel::data(const QModelIndex &index, int role) const
         return note.tagListScrollBarPos();
     case NoteIsPinned:
         return note.isPinnedNote();
+    case NotePreview:
+        return note.preview();
     }
 
     return {};
@@ -198,34 +400,117 @@ bool NoteListModel::setData(const QModelIndex &index, const QVariant &value, int
         return false;
     }
 
-    NodeData &note = getRef(index.row());
+    bool changed = false;
+    if (!updateRoleData(index.row(), value, role, changed)) {
+        return false;
+    }
+    if (changed) {
+        emit dataChanged(this->index(index.row()), this->index(index.row()), QVector<int>(1, role));
+    }
+    return true;
+}
+
+/*!
+ * \brief NoteListModel::setItemData
+ * Only roles whose value actually changed are written, and they are reported
+ * in a single dataChanged so the delegate relayouts the row at most once
+ */
+bool NoteListModel::setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles)
+{
+    if (index.row() < 0 || index.row() >= (m_noteList.count() + m_pinnedList.count())) {
+        return false;
+    }
+
+    bool ok = true;
+    QVector<int> changedRoles;
+    for (auto it = roles.constBegin(); it != roles.constEnd(); ++it) {
+        bool changed = false;
+        if (!updateRoleData(index.row(), it.value(), it.key(), changed)) {
+            ok = false;
+        } else if (changed) {
+            changedRoles.append(it.key());
+        }
+    }
+    if (!changedRoles.isEmpty()) {
+        emit dataChanged(this->index(index.row()), this->index(index.row()), changedRoles);
+    }
+    return ok;
+}
+
+bool NoteListModel::updateRoleData(int row, const QVariant &value, int role, bool &changed)
+{
+    NodeData &note = getRef(row);
+    changed = false;
     if (role == NoteID) {
-        note.setId(value.toInt());
+        if (note.id() != value.toInt()) {
+            m_idToRow.remove(note.id());
+            note.setId(value.toInt());
+            m_idToRow.insert(note.id(), row);
+            changed = true;
+        }
     } else if (role == NoteFullTitle) {
-        note.setFullTitle(value.toString());
+        if (note.fullTitle() != value.toString()) {
+            note.setFullTitle(value.toString());
+            note.setDisplayTitle(NodeData::getDisplayTitle(note.fullTitle()));
+            changed = true;
+        }
     } else if (role == NoteCreationDateTime) {
-        note.setCreationDateTime(value.toDateTime());
+        if (note.creationDateTime() != value.toDateTime()) {
+            note.setCreationDateTime(value.toDateTime());
+            changed = true;
+        }
     } else if (role == NoteLastModificationDateTime) {
-        note.setLastModificationDateTime(value.toDateTime());
+        if (note.lastModificationdateTime() != value.toDateTime()) {
+            note.setLastModificationDateTime(value.toDateTime());
+            changed = true;
+        }
     } else if (role == NoteDeletionDateTime) {
-        note.setDeletionDateTime(value.toDateTime());
+        if (note.deletionDateTime() != value.toDateTime()) {
+            note.setDeletionDateTime(value.toDateTime());
+            changed = true;
+        }
     } else if (role == NoteContent) {
-        note.setContent(value.toString());
+        auto content = value.toString();
+        if (!note.isContentLoaded() || note.content() != content) {
+            note.setContent(content);
+            note.setIsContentLoaded(true);
+            changed = true;
+        }
     } else if (role == NoteScrollbarPos) {
-        note.setScrollBarPosition(value.toInt());
+        if (note.scrollBarPosition() != value.toInt()) {
+            note.setScrollBarPosition(value.toInt());
+            changed = true;
+        }
     } else if (role == NoteTagsList) {
-        note.setTagIds(value.value<QSet<int>>());
+        auto tagIds = value.value<TagIdList>();
+        std::sort(tagIds.begin(), tagIds.end());
+        if (note.tagIdList() != tagIds) {
+            note.setTagIdList(tagIds);
+            changed = true;
+        }
     } else if (role == NoteIsTemp) {
-        note.setIsTempNote(value.toBool());
+        if (note.isTempNote() != value.toBool()) {
+            note.setIsTempNote(value.toBool());
+            changed = true;
+        }
     } else if (role == NoteParentName) {
-        note.setParentName(value.toString());
+        if (note.parentName() != value.toString()) {
+            note.setParentName(value.toString());
+            changed = true;
+        }
     } else if (role == NoteTagListScrollbarPos) {
-        note.setTagListScrollBarPos(value.toInt());
+        if (note.tagListScrollBarPos() != value.toInt()) {
+            note.setTagListScrollBarPos(value.toInt());
+            changed = true;
+        }
+    } else if (role == NotePreview) {
+        if (note.preview() != value.toString()) {
+            note.setPreview(value.toString());
+            changed = true;
+        }
     } else {
         return false;
     }
-
-    emit dataChanged(this->index(index.row()), this->index(index.row()), QVector<int>(1, role));
     return true;
 }
 
@@ -248,22 +533,28 @@ void NoteListModel::sort(int column, Qt::SortOrder order)
 {
     Q_UNUSED(column)
     Q_UNUSED(order)
+    sortNoteList(m_pinnedList, m_noteList);
+    rebuildIdIndex();
+
+    emit dataChanged(index(0), index(rowCount() - 1));
+}
+
+void NoteListModel::sortNoteList(QVector<NodeData> &pinnedList, QVector<NodeData> &noteList) const
+{
     if (m_listViewInfo.parentFolderId == TRASH_FOLDER_ID) {
-        std::stable_sort(m_noteList.begin(), m_noteList.end(),
-                         [](const NodeData &lhs, const NodeData &rhs) { return lhs.deletionDateTime() > rhs.deletionDateTime(); });
+        std::stable_sort(noteList.begin(), noteList.end(),
+                         [](const NodeData &lhs, const NodeData &rhs) { return lhs.deletionTime() > rhs.deletionTime(); });
     } else {
-        std::stable_sort(m_pinnedList.begin(), m_pinnedList.end(), [this](const NodeData &lhs, const NodeData &rhs) {
+        std::stable_sort(pinnedList.begin(), pinnedList.end(), [this](const NodeData &lhs, const NodeData &rhs) {
             if (isInAllNote()) {
                 return lhs.relativePosAN() < rhs.relativePosAN();
             }
             return lhs.relativePosition() < rhs.relativePosition();
         });
 
-        std::stable_sort(m_noteList.begin(), m_noteList.end(),
-                         [](const NodeData &lhs, const NodeData &rhs) { return lhs.lastModificationdateTime() > rhs.lastModificationdateTime(); });
+        std::stable_sort(noteList.begin(), noteList.end(),
+                         [](const NodeData &lhs, const NodeData &rhs) { return lhs.lastModificationTime() > rhs.lastModificationTime(); });
     }
-
-    emit dataChanged(index(0), index(rowCount() - 1));
 }
 
 void NoteListModel::setNoteData(const QModelIndex &index, const NodeData &note)
@@ -272,6 +563,8 @@ void NoteListModel::setNoteData(const QModelIndex &index, const NodeData &note)
         return;
     }
     auto row = index.row();
+    m_idToRow.remove(getRef(row).id());
+    m_idToRow.insert(note.id(), row);
     if (row < m_pinnedList.size()) {
         m_pinnedList[row] = note;
     } else {
@@ -317,14 +610,16 @@ bool NoteListModel::removeRows(int row, int count, const QModelIndex &parent)
         return false;
     }
     beginRemoveRows(parent, row, row + count - 1);
-    for (int r = row; r < row + count; ++r) {
+    // walk backwards, taking a row shifts every row after it up by one
+    for (int r = row + count - 1; r >= row; --r) {
         if (r < m_pinnedList.size()) {
-            m_pinnedList.takeAt(r);
+            m_idToRow.remove(m_pinnedList.takeAt(r).id());
         } else {
             auto rr = r - m_pinnedList.size();
-            m_noteList.takeAt(rr);
+            m_idToRow.remove(m_noteList.takeAt(rr).id());
         }
     }
+    updateIdIndex(row, rowCount() - 1);
     endRemoveRows();
     emit rowCountChanged();
     return true;
@@ -382,6 +677,7 @@ bool NoteListModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
     bool toPinned = row < m_pinnedList.size();
     auto idl = QString::fromUtf8(mime->data(NOTE_MIME)).split(PATH_SEPARATOR);
     QSet<int> movedIds;
+    QSet<int> pinChangedIds;
     QModelIndexList idxe;
     for (const auto &idString : std::as_const(idl)) {
         auto nodeId = idString.toInt();
@@ -394,7 +690,7 @@ bool NoteListModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
             auto &note = getRef(index.row());
             if (!note.isPinnedNote()) {
                 note.setIsPinnedNote(true);
-                emit requestUpdatePinned(note.id(), true);
+                pinChangedIds.insert(note.id());
                 m_pinnedList.prepend(m_noteList.takeAt(index.row() - m_pinnedList.size()));
             }
         }
@@ -416,19 +712,19 @@ bool NoteListModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
                 continue;
             }
             note.setIsPinnedNote(false);
-            emit requestUpdatePinned(note.id(), false);
+            pinChangedIds.insert(note.id());
             int destinationChild = 0;
             if (m_listViewInfo.parentFolderId == TRASH_FOLDER_ID) {
-                auto lastMod = index.data(NoteDeletionDateTime).toDateTime();
+                auto lastMod = note.deletionTime();
                 for (destinationChild = 0; destinationChild < m_noteList.size(); ++destinationChild) {
-                    if (m_noteList[destinationChild].deletionDateTime() <= lastMod) {
+                    if (m_noteList[destinationChild].deletionTime() <= lastMod) {
                         break;
                     }
                 }
             } else {
-                auto lastMod = index.data(NoteLastModificationDateTime).toDateTime();
+                auto lastMod = note.lastModificationTime();
                 for (destinationChild = 0; destinationChild < m_noteList.size(); ++destinationChild) {
-                    if (m_noteList[destinationChild].deletionDateTime() <= lastMod) {
+                    if (m_noteList[destinationChild].lastModificationTime() <= lastMod) {
                         break;
                     }
                 }
@@ -436,6 +732,7 @@ bool NoteListModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
             m_noteList.insert(destinationChild, m_pinnedList.takeAt(index.row()));
         }
     }
+    rebuildIdIndex();
 
     endResetModel();
     QModelIndexList destinations;
@@ -448,6 +745,9 @@ bool NoteListModel::dropMimeData(const QMimeData *mime, Qt::DropAction action, i
     }
     emit selectNotes(destinations);
     emit rowsMovedC(destinations);
+    if (!pinChangedIds.isEmpty()) {
+        emit requestUpdatePinned(pinChangedIds, toPinned);
+    }
     updatePinnedRelativePosition();
     return true;
 }
@@ -469,6 +769,12 @@ bool NoteListModel::hasPinnedNote() const
     return !m_pinnedList.isEmpty();
 }
 
+bool NoteListModel::hasTaggedNote() const
+{
+    auto hasTags = [](const NodeData &note) { return note.hasTags(); };
+    return std::any_of(m_pinnedList.cbegin(), m_pinnedList.cend(), hasTags) || std::any_of(m_noteList.cbegin(), m_noteList.cend(), hasTags);
+}
+
 void NoteListModel::setNotesIsPinned(const QModelIndexList &indexes, bool isPinned)
 {
     emit requestCloseNoteEditor(indexes);
@@ -481,10 +787,12 @@ void NoteListModel::setNotesIsPinned(const QModelIndexList &indexes, bool isPinn
                 needMovingIds.insert(note.id());
                 needMovingIndexes.append(index);
                 note.setIsPinnedNote(isPinned);
-                emit requestUpdatePinned(note.id(), isPinned);
             }
         }
     }
+    if (!needMovingIds.isEmpty()) {
+        emit requestUpdatePinned(needMovingIds, isPinned);
+    }
 
     if (isPinned) {
         emit rowsAboutToBeMovedC(needMovingIndexes);
@@ -499,6 +807,7 @@ void NoteListModel::setNotesIsPinned(const QModelIndexList &indexes, bool isPinn
                 continue;
             }
             m_pinnedList.prepend(m_noteList.takeAt(sourceRow - m_pinnedList.size()));
+            updateIdIndex(0, sourceRow);
         }
         endResetModel();
         QModelIndexList destinations;
@@ -523,23 +832,24 @@ void NoteListModel::setNotesIsPinned(const QModelIndexList &indexes, bool isPinn
             }
             int destinationChild = 0;
             if (m_listViewInfo.parentFolderId == TRASH_FOLDER_ID) {
-                auto lastMod = index.data(NoteDeletionDateTime).toDateTime();
+                auto lastMod = getRef(index.row()).deletionTime();
                 for (destinationChild = 0; destinationChild < m_noteList.size(); ++destinationChild) {
                     const auto &note = m_noteList[destinationChild];
-                    if (note.deletionDateTime() <= lastMod) {
+                    if (note.deletionTime() <= lastMod) {
                         break;
                     }
                 }
             } else {
-                auto lastMod = index.data(NoteLastModificationDateTime).toDateTime();
+                auto lastMod = getRef(index.row()).lastModificationTime();
                 for (destinationChild = 0; destinationChild < m_noteList.size(); ++destinationChild) {
                     const auto &note = m_noteList[destinationChild];
-                    if (note.lastModificationdateTime() <= lastMod) {
+                    if (note.lastModificationTime() <= lastMod) {
                         break;
                     }
                 }
             }
             m_noteList.insert(destinationChild, m_pinnedList.takeAt(index.row()));
+            updateIdIndex(index.row(), m_pinnedList.size() + destinationChild);
         }
         endResetModel();
         QModelIndexList destinations;
@@ -570,7 +880,7 @@ bool NoteListModel::noteIsHaveTag(const QModelIndex &index) const
         row = row - m_pinnedList.size();
         note = m_noteList[row];
     }
-    return !note.tagIds().empty();
+    return note.hasTags();
 }
 
 bool NoteListModel::isFirstPinnedNote(const QModelIndex &index) const
@@ -22,6 +22,7 @@ public:
         NoteParentName,
         NoteTagListScrollbarPos,
         NoteIsPinned,
+        NotePreview,
     };
 
     explicit NoteListModel(QObject *parent = nullptr);
@@ -33,11 +34,13 @@ public:
     QModelIndex getNoteIndex(int id) const;
     void setListNote(const QVector<NodeData> &notes, const ListViewInfo &inf);
     void removeNotes(const QModelIndexList &noteIndexes);
+    void removeNotesById(const QVector<int> &noteIds);
     bool moveRow(const QModelIndex &sourceParent, int sourceRow, const QModelIndex &destinationParent, int destinationChild);
 
     void clearNotes();
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    bool setItemData(const QModelIndex &index, const QMap<int, QVariant> &roles) override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     void sort(int column, Qt::SortOrder order) override;
@@ -55,20 +58,29 @@ public:
     QModelIndex getFirstPinnedNote() const;
     QModelIndex getFirstUnpinnedNote() const;
     bool hasPinnedNote() const;
+    bool hasTaggedNote() const;
     void setNotesIsPinned(const QModelIndexList &indexes, bool isPinned);
 
 private:
     QVector<NodeData> m_noteList;
     QVector<NodeData> m_pinnedList;
+    QHash<int, int> m_idToRow; // note id -> row, kept in sync by every mutation
     ListViewInfo m_listViewInfo;
     void updatePinnedRelativePosition();
+    void sortNoteList(QVector<NodeData> &pinnedList, QVector<NodeData> &noteList) const;
+    bool removeStaleRows(QVector<NodeData> &section, int offset, const QVector<NodeData> &target, int &budget, bool &structureChanged);
+    bool diffNoteSection(QVector<NodeData> &section, int offset, const QVector<NodeData> &target, int &budget, bool &structureChanged);
+    static bool isSameListEntry(const NodeData &lhs, const NodeData &rhs);
+    bool updateRoleData(int row, const QVariant &value, int role, bool &changed);
+    void rebuildIdIndex();
+    void updateIdIndex(int fromRow, int toRow);
     bool isInAllNote() const;
     NodeData &getRef(int row);
     const NodeData &getRef(int row) const;
 
 signals:
     void rowCountChanged();
-    void requestUpdatePinned(int noteId, bool isPinned);
+    void requestUpdatePinned(const QSet<int> &noteIds, bool isPinned);
     void requestUpdatePinnedRelPos(int noteId, int pos);
     void requestUpdatePinnedRelPosAN(int noteId, int pos);
     void requestRemoveNotes(QModelIndexList index);
@@ -22,6 +22,7 @@
 #include "notelistview_p.h"
 #include "notelistdelegateeditor.h"
 #include "fontloader.h"
+#include <algorithm>
 
 NoteListView::NoteListView(QWidget *parent)
     : QListView(parent),
@@ -116,6 +117,22 @@ void NoteListView::setIsPinnedNotesCollapsed(bool newIsPinnedNotesCollapsed)
     emit pinnedCollapseChanged();
 }
 
+/*!
+ * \brief NoteListView::updateUniformItemSizes
+ * Without pinned or tagged notes every row has the same height, so the view
+ * can measure one row instead of all of them. Turned off while rows animate.
+ */
+void NoteListView::updateUniformItemSizes()
+{
+    auto const *listModel = static_cast<NoteListModel *>(model());
+    auto *delegate = static_cast<NoteListDelegate *>(itemDelegate());
+    bool isUniform = (listModel != nullptr) && (delegate != nullptr) && (delegate->animationState() == QTimeLine::NotRunning)
+            && !listModel->hasPinnedNote() && !listModel->hasTaggedNote();
+    if (uniformItemSizes() != isUniform) {
+        setUniformItemSizes(isUniform);
+    }
+}
+
 void NoteListView::setCurrentIndexC(const QModelIndex &index)
 {
     setCurrentIndex(index);
@@ -161,9 +178,14 @@ void NoteListView::setCurrentFolderId(int newCurrentFolderId)
     m_currentFolderId = newCurrentFolderId;
 }
 
+/*!
+ * \brief NoteListView::openPersistentEditorC
+ * Tag chips of other rows are painted by NoteListDelegate, an editor widget is
+ * only created for the hovered and the selected rows
+ */
 void NoteListView::openPersistentEditorC(const QModelIndex &index)
 {
-    if (index.isValid()) {
+    if (index.isValid() && isEditorNeeded(index)) {
         auto isHaveTag = static_cast<NoteListModel *>(model())->noteIsHaveTag(index);
         if (isHaveTag) {
             auto id = index.data(NoteListModel::NoteID).toInt();
@@ -182,6 +204,34 @@ void NoteListView::closePersistentEditorC(const QModelIndex &index)
     }
 }
 
+bool NoteListView::isEditorNeeded(const QModelIndex &index) const
+{
+    if (selectionModel() != nullptr && selectionModel()->isSelected(index)) {
+        return true;
+    }
+    auto const *delegate = static_cast<NoteListDelegate *>(itemDelegate());
+    return (delegate != nullptr) && (delegate->hoveredIndex() == index);
+}
+
+void NoteListView::setHoveredIndexC(const QModelIndex &index)
+{
+    auto *delegate = static_cast<NoteListDelegate *>(itemDelegate());
+    if (delegate == nullptr) {
+        return;
+    }
+    QPersistentModelIndex previous = delegate->hoveredIndex();
+    delegate->setHoveredIndex(index);
+    if (previous == index) {
+        return;
+    }
+    if (previous.isValid() && !selectionModel()->isSelected(previous)) {
+        closePersistentEditorC(previous);
+    }
+    if (index.isValid() && !m_openedEditor.contains(index.data(NoteListModel::NoteID).toInt())) {
+        openPersistentEditorC(index);
+    }
+}
+
 void NoteListView::setEditorWidget(int noteId, QWidget *w)
 {
     if (m_openedEditor.contains(noteId)) {
@@ -365,7 +415,7 @@ bool NoteListView::viewportEvent(QEvent *e)
                 index = model()->index(index.row() - 1, 0);
                 auto *delegate = static_cast<NoteListDelegate *>(itemDelegate());
                 if (delegate != nullptr) {
-                    delegate->setHoveredIndex(QModelIndex());
+                    setHoveredIndexC(QModelIndex());
                     viewport()->update(visualRect(index));
                 }
             }
@@ -414,35 +464,58 @@ void NoteListView::scrollContentsBy(int dx, int dy)
 {
     QListView::scrollContentsBy(dx, dy);
     auto *listModel = static_cast<NoteListModel *>(model());
-    if (listModel == nullptr) {
+    if (listModel == nullptr || listModel->rowCount() == 0) {
         return;
     }
-    for (int i = 0; i < listModel->rowCount(); ++i) {
+    const auto range = abs(viewport()->height());
+    const auto openedIds = m_openedEditor.keys();
+    for (const auto id : openedIds) {
+        auto index = listModel->getNoteIndex(id);
+        if (!index.isValid()) {
+            continue;
+        }
+        auto y = visualRect(index).y();
+        if ((y < -range) || (y > 2 * range)) {
+            m_openedEditor.remove(id);
+            closePersistentEditor(index);
+        }
+    }
+
+    const auto rows = editorRowRange();
+    for (int i = rows.first; i <= rows.second; ++i) {
         auto index = listModel->index(i, 0);
-        if (index.isValid()) {
-            auto id = index.data(NoteListModel::NoteID).toInt();
-            if (m_openedEditor.contains(id)) {
-                auto y = visualRect(index).y();
-                auto range = abs(viewport()->height());
-                if ((y < -range) || (y > 2 * range)) {
-                    m_openedEditor.remove(id);
-                    closePersistentEditor(index);
-                }
-            } else {
-                auto y = visualRect(index).y();
-                auto range = abs(viewport()->height());
-                if (y < -range) {
-                    continue;
-                }
-                if (y > 2 * range) {
-                    break;
-                }
-                openPersistentEditorC(index);
-            }
+        if (!m_openedEditor.contains(index.data(NoteListModel::NoteID).toInt())) {
+            openPersistentEditorC(index);
         }
     }
 }
 
+/*!
+ * \brief NoteListView::editorRowRange
+ * Rows that may hold a persistent editor: the visible rows plus one viewport
+ * height each way. Returns an empty range (first > second) for an empty list
+ */
+QPair<int, int> NoteListView::editorRowRange() const
+{
+    const auto *listModel = static_cast<NoteListModel *>(model());
+    if (listModel == nullptr || listModel->rowCount() == 0) {
+        return { 0, -1 };
+    }
+    const auto range = abs(viewport()->height());
+    const auto x = viewport()->width() / 2;
+    auto firstVisible = indexAt(QPoint(x, 0));
+    auto lastVisible = indexAt(QPoint(x, viewport()->height() - 1));
+    int lastRow = lastVisible.isValid() ? lastVisible.row() : listModel->rowCount() - 1;
+    int firstRow = firstVisible.isValid() ? firstVisible.row() : lastRow;
+    while ((firstRow > 0) && (visualRect(listModel->index(firstRow - 1, 0)).y() >= -range)) {
+        --firstRow;
+    }
+    while ((lastRow < listModel->rowCount() - 1) && (visualRect(listModel->index(lastRow + 1, 0)).y() <= 2 * range)) {
+        ++lastRow;
+    }
+    return { firstRow, lastRow };
+}
+
 void NoteListView::startDrag(Qt::DropActions supportedActions)
 {
     Q_UNUSED(supportedActions);
@@ -586,18 +659,14 @@ void NoteListView::setupSignalsSlots()
                 viewport()->update(visualRect(prevIndex));
             }
 
-            auto *delegate = static_cast<NoteListDelegate *>(itemDelegate());
-            if (delegate)
-                delegate->setHoveredIndex(index);
+            setHoveredIndexC(index);
         }
     });
 
     // viewport was entered
     connect(this, &NoteListView::viewportEntered, this, [this]() {
         if (model() && model()->rowCount() > 1) {
-            auto *delegate = static_cast<NoteListDelegate *>(itemDelegate());
-            if (delegate)
-                delegate->setHoveredIndex(QModelIndex());
+            setHoveredIndexC(QModelIndex());
 
             QModelIndex lastIndex = model()->index(model()->rowCount() - 2, 0);
             viewport()->update(visualRect(lastIndex));
@@ -632,33 +701,33 @@ void NoteListView::setupStyleSheet()
 
 void NoteListView::addNotesToTag(QSet<int> const &notesId, int tagId)
 {
-    for (const auto &id : std::as_const(notesId)) {
-        auto const *noteListModel = static_cast<NoteListModel *>(this->model());
-        if (noteListModel != nullptr) {
-            auto index = noteListModel->getNoteIndex(id);
-            if (index.isValid()) {
-                emit addTagRequested(index, tagId);
-            }
-        }
+    if (!notesId.isEmpty()) {
+        emit addTagRequested(notesId, tagId);
     }
 }
 
 void NoteListView::removeNotesFromTag(QSet<int> const &notesId, int tagId)
 {
-    for (const auto &id : std::as_const(notesId)) {
-        auto const *noteListModel = static_cast<NoteListModel *>(this->model());
-        if (noteListModel != nullptr) {
-            auto index = noteListModel->getNoteIndex(id);
-            if (index.isValid()) {
-                emit removeTagRequested(index, tagId);
-            }
-        }
+    if (!notesId.isEmpty()) {
+        emit removeTagRequested(notesId, tagId);
     }
 }
 
 void NoteListView::selectionChanged(const QItemSelection &selected, const QItemSelection &deselected)
 {
     QListView::selectionChanged(selected, deselected);
+    for (const auto &index : deselected.indexes()) {
+        if (!isEditorNeeded(index)) {
+            closePersistentEditorC(index);
+        }
+    }
+    // rows scrolled into view later get their editor from scrollContentsBy
+    const auto rows = editorRowRange();
+    for (const auto &index : selected.indexes()) {
+        if (index.row() >= rows.first && index.row() <= rows.second && !m_openedEditor.contains(index.data(NoteListModel::NoteID).toInt())) {
+            openPersistentEditorC(index);
+        }
+    }
     QSet<int> ids;
     for (const auto &index : selectedIndexes()) {
         ids.insert(index.data(NoteListModel::NoteID).toInt());
@@ -715,8 +784,8 @@ void NoteListView::onCustomContextMenu(QPoint point)
             for (const auto &id : tagIds) {
                 bool all = true;
                 for (const auto &selectedIndex : std::as_const(indexList)) {
-                    auto tags = selectedIndex.data(NoteListModel::NoteTagsList).value<QSet<int>>();
-                    if (!tags.contains(id)) {
+                    auto tags = selectedIndex.data(NoteListModel::NoteTagsList).value<TagIdList>();
+                    if (!std::binary_search(tags.cbegin(), tags.cend(), id)) {
                         all = false;
                         break;
                     }
@@ -820,11 +889,15 @@ void NoteListView::onCustomContextMenu(QPoint point)
                 auto *action = new QAction(folders[id], this);
                 connect(action, &QAction::triggered, this, [this, id] {
                     auto indexes = selectedIndexes();
+                    QSet<int> noteIds;
                     for (const auto &selectedIndex : std::as_const(indexes)) {
                         if (selectedIndex.isValid()) {
-                            emit moveNoteRequested(selectedIndex.data(NoteListModel::NoteID).toInt(), id);
+                            noteIds.insert(selectedIndex.data(NoteListModel::NoteID).toInt());
                         }
                     }
+                    if (!noteIds.isEmpty()) {
+                        emit moveNotesRequested(noteIds, id);
+                    }
                 });
                 m->addAction(action);
                 m_folderActions.append(action);
@@ -843,10 +916,7 @@ void NoteListView::onAnimationFinished(NoteListState state)
     if (state == NoteListState::Remove) {
         auto *noteListModel = static_cast<NoteListModel *>(this->model());
         if (noteListModel != nullptr) {
-            for (const auto id : std::as_const(m_needRemovedNotes)) {
-                auto index = noteListModel->getNoteIndex(id);
-                noteListModel->removeRow(index.row());
-            }
+            noteListModel->removeNotesById(m_needRemovedNotes);
             m_needRemovedNotes.clear();
         }
     }
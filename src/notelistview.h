@@ -42,6 +42,7 @@ public:
     void setCurrentIndexC(const QModelIndex &index);
     QModelIndexList getSelectedIndex() const;
     bool isDraggingInsidePinned() const;
+    void updateUniformItemSizes();
 
 public slots:
     void onCustomContextMenu(QPoint point);
@@ -70,12 +71,12 @@ private slots:
     void init();
 
 signals:
-    void addTagRequested(const QModelIndex &index, int tadId);
-    void removeTagRequested(const QModelIndex &index, int tadId);
+    void addTagRequested(const QSet<int> &noteIds, int tadId);
+    void removeTagRequested(const QSet<int> &noteIds, int tadId);
     void deleteNoteRequested(const QModelIndexList &index);
     void restoreNoteRequested(const QModelIndexList &indexes);
     void newNoteRequested();
-    void moveNoteRequested(int noteId, int folderId);
+    void moveNotesRequested(const QSet<int> &noteIds, int folderId);
     void setPinnedNoteRequested(const QModelIndexList &indexes, bool isPinned);
     void saveSelectedNote(const QSet<int> &noteId);
     void pinnedCollapseChanged();
@@ -112,6 +113,9 @@ private:
     bool m_isDraggingInsidePinned;
     void setupSignalsSlots();
     void setupStyleSheet();
+    bool isEditorNeeded(const QModelIndex &index) const;
+    QPair<int, int> editorRowRange() const;
+    void setHoveredIndexC(const QModelIndex &index);
 
     void addNotesToTag(QSet<int> const &notesId, int tagId);
     void removeNotesFromTag(QSet<int> const &notesId, int tagId);
@@ -41,6 +41,7 @@ Item {
 //    https://scythe-studio.com/en/blog/how-to-integrate-c-and-qml-registering-enums
 
     Connections {
+        objectName: "mainWindowConnections"
         target: mainWindow
 
         function onEditorSettingsShowed (data) {
@@ -55,6 +55,7 @@ ApplicationWindow {
     }
 
     Connections {
+        objectName: "mainWindowConnections"
         target: mainWindow
 
         function onDisplayFontSet (data) {
@@ -12,7 +12,6 @@ MouseArea {
     property var todosColumnsViewPointerFromColumn
     property real yUntilTasks: columnTitle.y + columnTitle.height + tasksContainer.marginTop * 2
     property var tasksViewPointer: tasksView
-    property var titlesAndTasksData
     property int tasksScrollingDirection: 0
     property var themeData
     property int modelIndexBeforeDragged: DelegateModel.itemsIndex
@@ -14,7 +14,6 @@ Item {
     property int textAndTodosSpacing: 20
     property int todoColumnWidth: 250
     property int marginsSize: 10
-    property var titlesAndTasksData
     property var themeData: {"theme": "Light", "backgroundColor": "#f7f7f7"}
     property bool areTasksReversed: false
     property bool showSettingsPopup: false
@@ -31,8 +30,6 @@ Item {
     property string bodyFontFamily: "Avenir Next"
     property string displayFontFamily: "Roboto"
     property bool showColumnsBorders: false
-    property int newTaskInColumnID: -1
-    property var taskModelByColumnIDDict: ({})
     property string platform: ""
     property bool showEditorSettings: false
     property int pointSizeOffset: -4
@@ -49,136 +46,21 @@ Item {
     Material.theme: themeData.theme === "Dark" ? Material.Dark : Material.Light
     Material.accent: "#2383e2";
 
-    function reverseTasksData () {
-        for (let i = 0; i < titlesAndTasksData.length; i++) {
-            titlesAndTasksData[i].tasks.reverse();
-        }
-    }
-
     function toggleReverseTasks () {
-        root.reverseTasksData();
         root.areTasksReversed = !root.areTasksReversed;
-        columnModel.clear();
-        root.updateColumnModel();
-    }
-
-    function updateColumnModel() {
-        // Add columns and tasks
-        if (columnModel.count === 0) {
-            root.totalTasks = 0;
-            root.totalCompletedTasks = 0;
-
-            for (let i = 0; i < root.titlesAndTasksData.length; i++) {
-                root.totalTasks += root.titlesAndTasksData[i].tasks.length;
-                columnModel.append({"title": root.titlesAndTasksData[i].title, "columnID": i,
-                                       "columnStartLine": root.titlesAndTasksData[i].columnStartLine,
-                                       "columnEndLine": root.titlesAndTasksData[i].columnEndLine});
-            }
-
-            for (var n = 0; n < taskModelsRepeater.count; n++) {
-                root.titlesAndTasksData[n].tasks.forEach(taskData => {
-
-                                                             if (taskData.checked) {
-                                                                 root.totalCompletedTasks++;
-                                                             }
-
-                                                             taskModelsRepeater.itemAt(n).taskModel.append({"taskText": taskData.text, "taskChecked": taskData.checked,
-                                                                                                               "taskStartLine": taskData.taskStartLine,
-                                                                                                               "taskEndLine": taskData.taskEndLine,
-                                                                                                               "doNeedAnimateTaskCreation": false});
-                                                         });
-            }
-        } else {
-            // Update colums and tasks
-            for (let k = 0; k < root.titlesAndTasksData.length; k++) {
-                if (root.titlesAndTasksData[k]) {
-                    columnModel.set(k, {"columnStartLine": root.titlesAndTasksData[k].columnStartLine,
-                                        "columnEndLine": root.titlesAndTasksData[k].columnEndLine});
-
-                    var taskIndex = 0;
-                    var colID = columnModel.get(k).columnID;
-                    var tasksLength = root.titlesAndTasksData[k].tasks.length;
-
-                    root.titlesAndTasksData[k].tasks.forEach(taskData => {
-
-                                                                 var animateNoteCreation = false;
-                                                                 if (root.newTaskInColumnID === colID && taskIndex === tasksLength-1) {
-                                                                     root.newTaskInColumnID = -1;
-                                                                     animateNoteCreation = true;
-                                                                 }
-
-
-                                                                 root.taskModelByColumnIDDict[colID].set(taskIndex, {  "taskText": taskData.text, "doNeedAnimateTaskCreation": animateNoteCreation ? true : false,
-                                                                                                             "taskChecked": taskData.checked,
-                                                                                                             "taskStartLine": taskData.taskStartLine,
-                                                                                                             "taskEndLine": taskData.taskEndLine});
-
-                                                                 taskIndex++;
-
-                                                             });
-                }
-            }
-        }
+        kanbanColumnModel.tasksReversed = root.areTasksReversed;
     }
 
     FontIconLoader {
         id: fontIconLoader
     }
 
-    ListModel {
-        id: columnModel
-
-        function getNewColumnID() {
-            var previousLargest = -1;
-            for (let i = 0; i < columnModel.count; i++) {
-                if (columnModel.get(i).columnID > previousLargest) {
-                    previousLargest = columnModel.get(i).columnID;
-                }
-            }
-
-            return previousLargest + 1;
-        }
-    }
-
-    Repeater {
-        id: taskModelsRepeater
-        model: columnModel
-
-        // We replaced this with root.taskModelByColumnIDDict
-        function getTaskModelByColumnID (columnID: int) {
-            for (let i = 0; i < taskModelsRepeater.count; i++) {
-                if (taskModelsRepeater.itemAt(i).columnID === columnID) {
-                    return taskModelsRepeater.itemAt(i).taskModel;
-                }
-            }
-        }
-
-        delegate: Item {
-            property alias taskModel: taskModelChild
-            required property int columnID
-            ListModel {
-                id: taskModelChild
-            }
-        }
-
-        onItemAdded: (index, item) => {
-                         root.taskModelByColumnIDDict[item.columnID] = item.taskModel;
-                     }
-
-        onItemRemoved: (index, item) => {
-                           delete root.taskModelByColumnIDDict[item.columID];
-                       }
-    }
-
     Connections {
         target: noteEditorLogic
 
-        function onTasksFoundInEditor (data) {
-            root.titlesAndTasksData = data;
-            if (root.areTasksReversed) {
-                root.reverseTasksData();
-            }
-            root.updateColumnModel();
+        function onTasksFoundInEditor () {
+            root.totalTasks = kanbanColumnModel.taskCount();
+            root.totalCompletedTasks = kanbanColumnModel.completedTaskCount();
             root.showSettingsPopup = false;
 
             if (root.isMultipleNotesSelected && root.isForcedReadOnly) {
@@ -188,12 +70,12 @@ Item {
         }
 
         function onClearKanbanModel () {
-            columnModel.clear();
             root.showEditorSettings = false;
         }
 
         function onResetKanbanSettings () {
             root.areTasksReversed = false;
+            kanbanColumnModel.tasksReversed = false;
         }
 
         function onCheckMultipleNotesSelected (isMultipleNotesSelected) {
@@ -209,6 +91,7 @@ Item {
     }
 
     Connections {
+        objectName: "mainWindowConnections"
         target: mainWindow
 
         function onMainWindowResized (data) {
@@ -260,18 +143,18 @@ Item {
     }
 
     function rearrangeTasks (startLinePosition: int, endLinePosition: int, newLinePosition: int, columnInsertingIntoID, taskIndexToInsert, columnRemovingFromID, taskIndexToRemove, objectToInsert) {
-        root.taskModelByColumnIDDict[columnInsertingIntoID].insert(taskIndexToInsert, objectToInsert);
+        kanbanColumnModel.taskModelByColumnID(columnInsertingIntoID).insert(taskIndexToInsert, objectToInsert);
 
         if (columnInsertingIntoID === columnRemovingFromID && taskIndexToRemove > taskIndexToInsert) {
-            root.taskModelByColumnIDDict[columnRemovingFromID].remove(taskIndexToRemove + 1);
+            kanbanColumnModel.taskModelByColumnID(columnRemovingFromID).remove(taskIndexToRemove + 1);
         } else {
-            root.taskModelByColumnIDDict[columnRemovingFromID].remove(taskIndexToRemove);
+            kanbanColumnModel.taskModelByColumnID(columnRemovingFromID).remove(taskIndexToRemove);
         }
 
-        if (root.taskModelByColumnIDDict[columnRemovingFromID].count === 0) {
-            for (let i = 0; i < columnModel.count; i++) {
-                if (columnModel.get(i).columnID === columnRemovingFromID) {
-                    columnModel.remove(i);
+        if (kanbanColumnModel.taskModelByColumnID(columnRemovingFromID).count === 0) {
+            for (let i = 0; i < kanbanColumnModel.count; i++) {
+                if (kanbanColumnModel.get(i).columnID === columnRemovingFromID) {
+                    kanbanColumnModel.remove(i);
                     break;
                 }
             }
@@ -298,18 +181,18 @@ Item {
 
     function addNewTask (endLinePosition: int, columnID: int, newTaskText: string) {
         root.totalTasks++;
-        root.newTaskInColumnID = columnID;
-        root.taskModelByColumnIDDict[columnID].insert(root.taskModelByColumnIDDict[columnID].count, {"taskText": newTaskText, "taskStartLine:": endLinePosition, "taskEndLine": endLinePosition, "taskChecked": false, "doNeedAnimateTaskCreation": true})
+        var taskModelOfColumn = kanbanColumnModel.taskModelByColumnID(columnID);
+        taskModelOfColumn.insert(taskModelOfColumn.count, {"taskText": newTaskText, "taskStartLine": endLinePosition, "taskEndLine": endLinePosition, "taskChecked": false, "doNeedAnimateTaskCreation": true})
         noteEditorLogic.addNewTask(endLinePosition, newTaskText);
     }
 
     function removeTask (startLinePosition: int, endLinePosition: int, columnRemovingFromID, taskIndex) {
-        root.taskModelByColumnIDDict[columnRemovingFromID].remove(taskIndex);
+        kanbanColumnModel.taskModelByColumnID(columnRemovingFromID).remove(taskIndex);
 
-        if (root.taskModelByColumnIDDict[columnRemovingFromID].count === 0) {
-            for (let i = 0; i < columnModel.count; i++) {
-                if (columnModel.get(i).columnID === columnRemovingFromID) {
-                    columnModel.remove(i);
+        if (kanbanColumnModel.taskModelByColumnID(columnRemovingFromID).count === 0) {
+            for (let i = 0; i < kanbanColumnModel.count; i++) {
+                if (kanbanColumnModel.get(i).columnID === columnRemovingFromID) {
+                    kanbanColumnModel.remove(i);
                     break;
                 }
             }
@@ -322,19 +205,19 @@ Item {
         if (!root.isReadOnlyMode) {
             var columnTitle = "\n\n# Untitled\n\n- [ ] New task";
 
-            var newColumnID = columnModel.getNewColumnID();
+            var newColumnID = kanbanColumnModel.getNewColumnID();
 
-            if (columnModel.count > 0) {
-                let startLinePosition = columnModel.get(columnModel.count - 1).columnEndLine;
-                columnModel.append({"title": "Untitled", "columnID": newColumnID,
-                                       "columnStartLine": startLinePosition,
-                                       "columnEndLine": startLinePosition+2});
+            if (kanbanColumnModel.count > 0) {
+                let startLinePosition = kanbanColumnModel.get(kanbanColumnModel.count - 1).columnEndLine;
+                kanbanColumnModel.append({"title": "Untitled", "columnID": newColumnID,
+                                             "columnStartLine": startLinePosition,
+                                             "columnEndLine": startLinePosition+2});
                 noteEditorLogic.addNewColumn(startLinePosition, columnTitle);
             } else {
                 let columnTitle = "# Untitled\n\n- [ ] New task\n\n";
-                columnModel.append({"title": "Untitled", "columnID": newColumnID,
-                                       "columnStartLine": 0,
-                                       "columnEndLine": 2});
+                kanbanColumnModel.append({"title": "Untitled", "columnID": newColumnID,
+                                             "columnStartLine": 0,
+                                             "columnEndLine": 2});
                 noteEditorLogic.addNewColumn(0, columnTitle);
             }
 
@@ -349,7 +232,7 @@ Item {
     }
 
     function removeColumn (startLinePosition: int, endLinePosition: int, columnRemovingID: int) {
-        var taskModelOfColumn = root.taskModelByColumnIDDict[columnRemovingID];
+        var taskModelOfColumn = kanbanColumnModel.taskModelByColumnID(columnRemovingID);
 
         root.totalTasks -= taskModelOfColumn.count;
 
@@ -358,9 +241,9 @@ Item {
                 root.totalCompletedTasks--;
         }
 
-        for (let i = 0; i < columnModel.count; i++) {
-            if (columnModel.get(i).columnID === columnRemovingID) {
-                columnModel.remove(i);
+        for (let i = 0; i < kanbanColumnModel.count; i++) {
+            if (kanbanColumnModel.get(i).columnID === columnRemovingID) {
+                kanbanColumnModel.remove(i);
                 break;
             }
         }
@@ -373,8 +256,8 @@ Item {
     }
 
     function reRenderTask(columnID, taskIndex, taskObject) {
-        root.taskModelByColumnIDDict[columnID].remove(taskIndex);
-        root.taskModelByColumnIDDict[columnID].insert(taskIndex, taskObject);
+        kanbanColumnModel.taskModelByColumnID(columnID).remove(taskIndex);
+        kanbanColumnModel.taskModelByColumnID(columnID).insert(taskIndex, taskObject);
     }
 
     SubscriptionWindow {
@@ -397,7 +280,7 @@ Item {
 
         Text {
             id: noTasksFoundText
-            visible: columnModel.count === 0
+            visible: kanbanColumnModel.count === 0
             text: "No tasks found in this note.<br/>Create a new column using the <b>+ button</b>."
             color: root.themeData.theme === "Dark" ? "white" : "black"
             font.pointSize: root.platform === "Apple" ? 23 : 23 + root.pointSizeOffset
@@ -456,18 +339,17 @@ Item {
 
             DelegateModel {
                 id: visualModel
-                model: columnModel
+                model: kanbanColumnModel
 
                 delegate: TodoColumnDelegate {
                     todoColumnContentHeight: todosContainer.height - root.marginsSize*3
                     rootContainer: root
                     rootTodoContainer: todosContainer
                     todosColumnsViewPointerFromColumn: todosColumnsView
-                    titlesAndTasksData: root.titlesAndTasksData
                     themeData: root.themeData
                     areTasksReversed: root.areTasksReversed
-                    columnModelPointer: columnModel
-                    taskModel: root.taskModelByColumnIDDict[columnID]
+                    columnModelPointer: kanbanColumnModel
+                    taskModel: kanbanColumnModel.taskModelByColumnID(columnID)
                 }
             }
 
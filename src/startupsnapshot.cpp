@@ -0,0 +1,176 @@
+#include "startupsnapshot.h"
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+
+#define STARTUP_SNAPSHOT_MAGIC 0x4E534E50 // "NSNP"
+#define STARTUP_SNAPSHOT_VERSION 2
+
+static void writeNode(QDataStream &out, const NodeData &node)
+{
+    out << node.id() << node.fullTitle() << static_cast<qint32>(node.nodeType()) << node.parentId() << node.relativePosition()
+        << node.absolutePath() << node.childNotesCount() << node.lastModificationTime() << node.creationTime() << node.deletionTime()
+        << node.isPinnedNote() << node.relativePosAN() << node.parentName() << node.displayTitle() << node.preview();
+    out << static_cast<qint32>(node.tagIdList().size());
+    for (const auto tagId : node.tagIdList()) {
+        out << tagId;
+    }
+}
+
+static NodeData readNode(QDataStream &in)
+{
+    int id, parentId, relativePosition, childNotesCount, relativePosAN;
+    qint32 nodeType, tagCount;
+    qint64 lastModificationTime, creationTime, deletionTime;
+    bool isPinnedNote;
+    QString fullTitle, absolutePath, parentName, displayTitle, preview;
+    in >> id >> fullTitle >> nodeType >> parentId >> relativePosition >> absolutePath >> childNotesCount >> lastModificationTime >> creationTime
+            >> deletionTime >> isPinnedNote >> relativePosAN >> parentName >> displayTitle >> preview >> tagCount;
+    QSet<int> tagIds;
+    for (qint32 i = 0; i < tagCount && in.status() == QDataStream::Ok; ++i) {
+        int tagId;
+        in >> tagId;
+        tagIds.insert(tagId);
+    }
+
+    NodeData node;
+    node.setId(id);
+    node.setFullTitle(fullTitle);
+    node.setNodeType(static_cast<NodeData::Type>(nodeType));
+    node.setParentId(parentId);
+    node.setRelativePosition(relativePosition);
+    node.setAbsolutePath(absolutePath);
+    node.setChildNotesCount(childNotesCount);
+    node.setLastModificationTime(lastModificationTime);
+    node.setCreationTime(creationTime);
+    node.setDeletionTime(deletionTime);
+    node.setIsPinnedNote(isPinnedNote);
+    node.setRelativePosAN(relativePosAN);
+    node.setParentName(parentName);
+    node.setDisplayTitle(displayTitle);
+    node.setPreview(preview);
+    node.setTagIds(tagIds);
+    node.setIsContentLoaded(false);
+    return node;
+}
+
+static void writeTag(QDataStream &out, const TagData &tag)
+{
+    out << tag.id() << tag.name() << tag.color() << tag.relativePosition() << tag.childNotesCount();
+}
+
+static TagData readTag(QDataStream &in)
+{
+    int id, relativePosition, childNotesCount;
+    QString name, color;
+    in >> id >> name >> color >> relativePosition >> childNotesCount;
+
+    TagData tag;
+    tag.setId(id);
+    tag.setName(name);
+    tag.setColor(color);
+    tag.setRelativePosition(relativePosition);
+    tag.setChildNotesCount(childNotesCount);
+    return tag;
+}
+
+ListViewInfo StartupSnapshot::listViewInfo() const
+{
+    ListViewInfo inf;
+    inf.isInSearch = false;
+    inf.isInTag = isInTag;
+    inf.currentTagList = currentTagList;
+    inf.parentFolderId = parentFolderId;
+    inf.currentNotesId = { INVALID_NODE_ID };
+    inf.needCreateNewNote = false;
+    inf.scrollToId = INVALID_NODE_ID;
+    return inf;
+}
+
+/*!
+ * \brief StartupSnapshot::read
+ * The file is memory-mapped and decoded in place, so nothing but the
+ * resulting strings is copied. Returns false on a missing, foreign or
+ * truncated file, in which case the snapshot is left untouched.
+ * \param fileName
+ * \return
+ */
+bool StartupSnapshot::read(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        return false;
+    }
+    uchar *data = file.map(0, file.size());
+    if (data == nullptr) {
+        return false;
+    }
+    const QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(data), file.size());
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic, version;
+    in >> magic >> version;
+    if (magic != STARTUP_SNAPSHOT_MAGIC || version != STARTUP_SNAPSHOT_VERSION) {
+        return false;
+    }
+
+    StartupSnapshot snapshot;
+    qint32 folderCount, tagCount, noteCount, currentTagCount;
+    in >> snapshot.dbPath >> snapshot.allNotesCount >> snapshot.trashCount >> snapshot.isInTag >> snapshot.parentFolderId >> snapshot.listLabel1 >> snapshot.listLabel2 >> currentTagCount;
+    for (qint32 i = 0; i < currentTagCount && in.status() == QDataStream::Ok; ++i) {
+        int tagId;
+        in >> tagId;
+        snapshot.currentTagList.insert(tagId);
+    }
+    in >> folderCount;
+    for (qint32 i = 0; i < folderCount && in.status() == QDataStream::Ok; ++i) {
+        snapshot.treeData.nodeTreeData.append(readNode(in));
+    }
+    in >> tagCount;
+    for (qint32 i = 0; i < tagCount && in.status() == QDataStream::Ok; ++i) {
+        snapshot.treeData.tagTreeData.append(readTag(in));
+    }
+    in >> noteCount;
+    for (qint32 i = 0; i < noteCount && in.status() == QDataStream::Ok; ++i) {
+        snapshot.notes.append(readNode(in));
+    }
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << __FUNCTION__ << __LINE__ << "Discarding corrupt startup snapshot" << fileName;
+        return false;
+    }
+
+    *this = snapshot;
+    return true;
+}
+
+bool StartupSnapshot::write(const QString &fileName) const
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << __FUNCTION__ << __LINE__ << file.errorString();
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+
+    out << static_cast<quint32>(STARTUP_SNAPSHOT_MAGIC) << static_cast<quint32>(STARTUP_SNAPSHOT_VERSION);
+    out << dbPath << allNotesCount << trashCount << isInTag << parentFolderId << listLabel1 << listLabel2 << static_cast<qint32>(currentTagList.size());
+    for (const auto tagId : currentTagList) {
+        out << tagId;
+    }
+    out << static_cast<qint32>(treeData.nodeTreeData.size());
+    for (const auto &node : treeData.nodeTreeData) {
+        writeNode(out, node);
+    }
+    out << static_cast<qint32>(treeData.tagTreeData.size());
+    for (const auto &tag : treeData.tagTreeData) {
+        writeTag(out, tag);
+    }
+    out << static_cast<qint32>(notes.size());
+    for (const auto &note : notes) {
+        writeNode(out, note);
+    }
+    return file.commit();
+}
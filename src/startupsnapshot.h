@@ -0,0 +1,32 @@
+#ifndef STARTUPSNAPSHOT_H
+#define STARTUPSNAPSHOT_H
+
+#include "dbmanager.h"
+
+/*!
+ * \brief The StartupSnapshot struct
+ * Compact copy of what the window shows right after launch: the folder tree,
+ * the tag list, the All Notes / Trash counts and the summaries of the last
+ * viewed list page. It is painted before the database is open and replaced
+ * once DBManager delivers the real data. dbPath names the database it was
+ * taken from, a snapshot of another database is never painted.
+ */
+struct StartupSnapshot
+{
+    QString dbPath;
+    NodeTagTreeData treeData;
+    int allNotesCount = 0;
+    int trashCount = 0;
+    bool isInTag = false;
+    int parentFolderId = ROOT_FOLDER_ID;
+    QSet<int> currentTagList;
+    QString listLabel1;
+    QString listLabel2;
+    QVector<NodeData> notes;
+
+    ListViewInfo listViewInfo() const;
+    bool read(const QString &fileName);
+    bool write(const QString &fileName) const;
+};
+
+#endif // STARTUPSNAPSHOT_H
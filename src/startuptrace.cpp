@@ -0,0 +1,104 @@
+#include "startuptrace.h"
+#include <QEvent>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <QTimer>
+#include <algorithm>
+
+StartupTrace::StartupTrace(QObject *parent) : QObject(parent), m_isEnabled(qEnvironmentVariableIsSet("NOTES_STARTUP_TRACE"))
+{
+    m_timer.start();
+}
+
+StartupTrace *StartupTrace::instance()
+{
+    static StartupTrace trace;
+    return &trace;
+}
+
+void StartupTrace::setEnabled(bool isEnabled)
+{
+    m_isEnabled = isEnabled;
+}
+
+void StartupTrace::mark(const QString &phase)
+{
+    if (!m_isEnabled) {
+        return;
+    }
+    {
+        QMutexLocker locker(&m_mutex);
+        m_marks.append({ phase, m_timer.nsecsElapsed() });
+    }
+    emit marked(phase);
+}
+
+/*!
+ * \brief StartupTrace::markOnce
+ * Like mark(), but only the first occurrence of phase is recorded. Used for
+ * code paths that also run after startup, like loading the tree. Returns
+ * true if this call recorded it.
+ */
+bool StartupTrace::markOnce(const QString &phase)
+{
+    if (!m_isEnabled) {
+        return false;
+    }
+    {
+        // the check and the insert share the lock, the GUI and the database
+        // threads may race for the same phase
+        QMutexLocker locker(&m_mutex);
+        if (std::any_of(m_marks.cbegin(), m_marks.cend(), [&phase](const QPair<QString, qint64> &m) { return m.first == phase; })) {
+            return false;
+        }
+        m_marks.append({ phase, m_timer.nsecsElapsed() });
+    }
+    emit marked(phase);
+    return true;
+}
+
+/*!
+ * \brief StartupTrace::markOnFirstPaint
+ * Records phase the next time widget receives a paint event
+ */
+void StartupTrace::markOnFirstPaint(QObject *widget, const QString &phase)
+{
+    if (!m_isEnabled || hasMark(phase) || m_paintWatches.contains(widget)) {
+        return;
+    }
+    m_paintWatches.insert(widget, phase);
+    widget->installEventFilter(this);
+}
+
+bool StartupTrace::hasMark(const QString &phase) const
+{
+    QMutexLocker locker(&m_mutex);
+    return std::any_of(m_marks.cbegin(), m_marks.cend(), [&phase](const QPair<QString, qint64> &m) { return m.first == phase; });
+}
+
+QString StartupTrace::report() const
+{
+    QMutexLocker locker(&m_mutex);
+    QString result;
+    QTextStream out(&result);
+    out << QStringLiteral("%1 %2 %3\n").arg(QStringLiteral("phase"), -32).arg(QStringLiteral("delta (ms)"), 12).arg(QStringLiteral("total (ms)"), 12);
+    qint64 previous = 0;
+    for (const auto &m : m_marks) {
+        out << QStringLiteral("%1 %2 %3\n")
+                        .arg(m.first, -32)
+                        .arg((m.second - previous) / 1e6, 12, 'f', 2)
+                        .arg(m.second / 1e6, 12, 'f', 2);
+        previous = m.second;
+    }
+    return result;
+}
+
+bool StartupTrace::eventFilter(QObject *object, QEvent *event)
+{
+    if (event->type() == QEvent::Paint && m_paintWatches.contains(object)) {
+        object->removeEventFilter(this);
+        // take the timestamp once the widget is done painting
+        QTimer::singleShot(0, this, [this, phase = m_paintWatches.take(object)]() { mark(phase); });
+    }
+    return QObject::eventFilter(object, event);
+}
@@ -0,0 +1,47 @@
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QVector>
+#include <atomic>
+
+/*!
+ * \brief The StartupTrace class
+ * Records how long each launch phase took, measured from the start of main().
+ * mark() may be called from any thread. Disabled unless --benchmark-startup
+ * is passed or NOTES_STARTUP_TRACE is set, marks are dropped while disabled.
+ */
+class StartupTrace : public QObject
+{
+    Q_OBJECT
+public:
+    static StartupTrace *instance();
+
+    void setEnabled(bool isEnabled);
+    void mark(const QString &phase);
+    bool markOnce(const QString &phase);
+    void markOnFirstPaint(QObject *widget, const QString &phase);
+    bool hasMark(const QString &phase) const;
+    QString report() const;
+
+signals:
+    void marked(const QString &phase);
+
+protected:
+    bool eventFilter(QObject *object, QEvent *event) override;
+
+private:
+    explicit StartupTrace(QObject *parent = nullptr);
+
+    std::atomic_bool m_isEnabled;
+    mutable QMutex m_mutex;
+    QElapsedTimer m_timer;
+    QVector<QPair<QString, qint64>> m_marks;
+    QHash<QObject *, QString> m_paintWatches;
+};
+
+#endif // STARTUPTRACE_H
@@ -1,6 +1,7 @@
 #include "taglistmodel.h"
 #include "tagpool.h"
 #include <QDebug>
+#include <algorithm>
 
 TagListModel::TagListModel(QObject *parent) : QAbstractListModel(parent), m_tagPool{ nullptr } { }
 
@@ -69,7 +70,10 @@ QVariant TagListModel::data(const QModelIndex &index, int role) const
 void TagListModel::updateTagData()
 {
     m_data.clear();
-    for (const auto &id : std::as_const(m_ids)) {
+    // same order as the chips NoteListDelegate paints for rows without an editor
+    auto ids = m_ids.values();
+    std::sort(ids.begin(), ids.end());
+    for (const auto &id : std::as_const(ids)) {
         if (m_tagPool->contains(id)) {
             m_data.append(m_tagPool->getTag(id));
         } else {
@@ -3,15 +3,7 @@
 
 TagPool::TagPool(DBManager *dbManager, QObject *parent) : QObject(parent), m_dbManager{ dbManager }
 {
-    connect(
-            m_dbManager, &DBManager::nodesTagTreeReceived, this,
-            [this](const NodeTagTreeData &treeData) {
-                QMap<int, TagData> newPool;
-                for (const auto &tag : treeData.tagTreeData) {
-                    newPool[tag.id()] = tag;
-                }
-                setTagPool(newPool);
-            },
+    connect(m_dbManager, &DBManager::nodesTagTreeReceived, this, [this](const NodeTagTreeData &treeData) { setTagList(treeData.tagTreeData); },
             Qt::QueuedConnection);
     connect(m_dbManager, &DBManager::tagAdded, this, &TagPool::onTagAdded, Qt::QueuedConnection);
     connect(m_dbManager, &DBManager::tagRemoved, this, &TagPool::onTagDeleted, Qt::QueuedConnection);
@@ -19,6 +11,15 @@ TagPool::TagPool(DBManager *dbManager, QObject *parent) : QObject(parent), m_dbM
     connect(m_dbManager, &DBManager::tagColorChanged, this, &TagPool::onTagColorChanged, Qt::QueuedConnection);
 }
 
+void TagPool::setTagList(const QVector<TagData> &tagList)
+{
+    QMap<int, TagData> newPool;
+    for (const auto &tag : tagList) {
+        newPool[tag.id()] = tag;
+    }
+    setTagPool(newPool);
+}
+
 void TagPool::setTagPool(const QMap<int, TagData> &newPool)
 {
     m_pool = newPool;
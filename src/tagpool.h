@@ -15,6 +15,7 @@ public:
     TagData getTag(int id) const;
     bool contains(int id) const;
     QList<int> tagIds() const;
+    void setTagList(const QVector<TagData> &tagList);
 
 signals:
     void dataReset();
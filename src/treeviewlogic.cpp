@@ -2,6 +2,7 @@
 #include "nodetreeview.h"
 #include "nodetreemodel.h"
 #include "nodetreedelegate.h"
+#include "startuptrace.h"
 #include "notelistview.h"
 #include <QDebug>
 #include <QMetaObject>
@@ -39,11 +40,12 @@ TreeViewLogic::TreeViewLogic(NodeTreeView *treeView, NodeTreeModel *treeModel, D
     connect(m_treeView, &NodeTreeView::deleteTagRequested, this, &TreeViewLogic::onDeleteTagRequested);
     connect(this, &TreeViewLogic::requestChangeTagColorInDB, m_dbManager, &DBManager::changeTagColor, Qt::QueuedConnection);
     connect(this, &TreeViewLogic::requestMoveNodeInDB, m_dbManager, &DBManager::moveNode, Qt::QueuedConnection);
-    connect(m_treeView, &NodeTreeView::moveNodeRequested, this, [this](int nodeId, int targetId) {
-        onMoveNodeRequested(nodeId, targetId);
-        emit noteMoved(nodeId, targetId);
+    connect(this, &TreeViewLogic::requestMoveNotesInDB, m_dbManager, &DBManager::moveNotes, Qt::QueuedConnection);
+    connect(m_treeView, &NodeTreeView::moveNotesRequested, this, [this](const QSet<int> &noteIds, int targetId) {
+        onMoveNotesRequested(noteIds, targetId);
+        emit notesMoved(noteIds, targetId);
     });
-    connect(m_treeView, &NodeTreeView::addNoteToTag, this, &TreeViewLogic::addNoteToTag);
+    connect(m_treeView, &NodeTreeView::addNotesToTag, this, &TreeViewLogic::addNotesToTag);
     connect(m_treeModel, &NodeTreeModel::requestExpand, m_treeView, &NodeTreeView::onRequestExpand);
     connect(m_treeModel, &NodeTreeModel::requestUpdateAbsPath, m_treeView, &NodeTreeView::onUpdateAbsPath);
     connect(m_treeModel, &NodeTreeModel::requestMoveNode, this, &TreeViewLogic::onMoveNodeRequested);
@@ -54,6 +56,10 @@ TreeViewLogic::TreeViewLogic(NodeTreeView *treeView, NodeTreeModel *treeModel, D
     connect(m_treeModel, &NodeTreeModel::requestMoveFolderToTrash, this, &TreeViewLogic::onDeleteFolderRequested);
     connect(m_dbManager, &DBManager::childNotesCountUpdatedFolder, this, &TreeViewLogic::onChildNoteCountChangedFolder);
     connect(m_dbManager, &DBManager::childNotesCountUpdatedTag, this, &TreeViewLogic::onChildNotesCountChangedTag);
+    // count updates arrive one signal per item, apply them once per event loop turn
+    m_childNotesCountTimer.setSingleShot(true);
+    m_childNotesCountTimer.setInterval(0);
+    connect(&m_childNotesCountTimer, &QTimer::timeout, this, &TreeViewLogic::applyPendingChildNotesCounts);
     m_style = new CustomApplicationStyle();
     qApp->setStyle(m_style);
 }
@@ -65,25 +71,23 @@ void TreeViewLogic::updateTreeViewSeparator()
 
 void TreeViewLogic::loadTreeModel(const NodeTagTreeData &treeData)
 {
-    m_treeModel->setTreeData(treeData);
-    {
-        NodeData node;
-        QMetaObject::invokeMethod(m_dbManager, "getChildNotesCountFolder", Qt::BlockingQueuedConnection, Q_RETURN_ARG(NodeData, node),
-                                  Q_ARG(int, ROOT_FOLDER_ID));
-        auto index = m_treeModel->getAllNotesButtonIndex();
-        if (index.isValid()) {
-            m_treeModel->setData(index, node.childNotesCount(), NodeItem::Roles::ChildCount);
-        }
-    }
-    {
-        NodeData node;
-        QMetaObject::invokeMethod(m_dbManager, "getChildNotesCountFolder", Qt::BlockingQueuedConnection, Q_RETURN_ARG(NodeData, node),
-                                  Q_ARG(int, TRASH_FOLDER_ID));
-        auto index = m_treeModel->getTrashButtonIndex();
-        if (index.isValid()) {
-            m_treeModel->setData(index, node.childNotesCount(), NodeItem::Roles::ChildCount);
+    // the root and trash folders come with the tree, take their counts from
+    // there instead of asking the database thread again
+    int allNotesCount = 0;
+    int trashCount = 0;
+    for (const auto &node : treeData.nodeTreeData) {
+        if (node.id() == ROOT_FOLDER_ID) {
+            allNotesCount = node.childNotesCount();
+        } else if (node.id() == TRASH_FOLDER_ID) {
+            trashCount = node.childNotesCount();
         }
     }
+    // counts queued before this tree was read are older than the ones it carries
+    m_childNotesCountTimer.stop();
+    m_pendingFolderCounts.clear();
+    m_pendingTagCounts.clear();
+    m_treeModel->setTreeData(treeData);
+    setAllNotesAndTrashCount(allNotesCount, trashCount);
     if (m_needLoadSavedState) {
         m_needLoadSavedState = false;
         m_treeView->reExpandC(m_expandedFolder);
@@ -110,11 +114,51 @@ void TreeViewLogic::loadTreeModel(const NodeTagTreeData &treeData)
         m_lastSelectTags.clear();
         m_expandedFolder.clear();
     } else {
-        m_treeView->setCurrentIndexC(m_treeModel->getAllNotesButtonIndex());
+        // an incremental tree update keeps the selected folder or tag, reselect
+        // it so its note list is reloaded
+        auto selected = m_treeView->selectionModel()->selectedIndexes();
+        if (selected.size() == 1 && selected.first().isValid()) {
+            m_treeView->setCurrentIndexC(selected.first());
+        } else {
+            m_treeView->setCurrentIndexC(m_treeModel->getAllNotesButtonIndex());
+        }
+    }
+    updateTreeViewSeparator();
+    StartupTrace::instance()->markOnce(QStringLiteral("first tree load"));
+}
+
+/*!
+ * \brief TreeViewLogic::loadTreeSnapshot
+ * Paints the tree from the startup snapshot while the database is still
+ * opening. Nothing is selected, so no list load is triggered; the saved
+ * state is restored once loadTreeModel receives the real tree.
+ */
+void TreeViewLogic::loadTreeSnapshot(const NodeTagTreeData &treeData, int allNotesCount, int trashCount)
+{
+    // counts queued before this tree was read are older than the ones it carries
+    m_childNotesCountTimer.stop();
+    m_pendingFolderCounts.clear();
+    m_pendingTagCounts.clear();
+    m_treeModel->setTreeData(treeData);
+    setAllNotesAndTrashCount(allNotesCount, trashCount);
+    if (m_needLoadSavedState) {
+        m_treeView->reExpandC(m_expandedFolder);
     }
     updateTreeViewSeparator();
 }
 
+void TreeViewLogic::setAllNotesAndTrashCount(int allNotesCount, int trashCount)
+{
+    auto index = m_treeModel->getAllNotesButtonIndex();
+    if (index.isValid()) {
+        m_treeModel->setData(index, allNotesCount, NodeItem::Roles::ChildCount);
+    }
+    index = m_treeModel->getTrashButtonIndex();
+    if (index.isValid()) {
+        m_treeModel->setData(index, trashCount, NodeItem::Roles::ChildCount);
+    }
+}
+
 void TreeViewLogic::onAddFolderRequested(bool fromPlusButton)
 {
     QModelIndex currentIndex;
@@ -296,25 +340,28 @@ void TreeViewLogic::onDeleteTagRequested(const QModelIndex &index)
 
 void TreeViewLogic::onChildNotesCountChangedTag(int tagId, int notesCount)
 {
-    auto index = m_treeModel->tagIndexFromId(tagId);
-    if (index.isValid()) {
-        m_treeModel->setData(index, notesCount, NodeItem::Roles::ChildCount);
+    m_pendingTagCounts[tagId] = notesCount;
+    if (!m_childNotesCountTimer.isActive()) {
+        m_childNotesCountTimer.start();
     }
 }
 
-void TreeViewLogic::onChildNoteCountChangedFolder(int folderId, const QString &absPath, int notesCount)
+void TreeViewLogic::onChildNoteCountChangedFolder(int folderId, int notesCount)
 {
-    QModelIndex index;
-    if (folderId == ROOT_FOLDER_ID) {
-        index = m_treeModel->getAllNotesButtonIndex();
-    } else if (folderId == TRASH_FOLDER_ID) {
-        index = m_treeModel->getTrashButtonIndex();
-    } else {
-        index = m_treeModel->folderIndexFromIdPath(absPath);
+    m_pendingFolderCounts[folderId] = notesCount;
+    if (!m_childNotesCountTimer.isActive()) {
+        m_childNotesCountTimer.start();
     }
-    if (index.isValid()) {
-        m_treeModel->setData(index, notesCount, NodeItem::Roles::ChildCount);
+}
+
+void TreeViewLogic::applyPendingChildNotesCounts()
+{
+    if (m_pendingFolderCounts.isEmpty() && m_pendingTagCounts.isEmpty()) {
+        return;
     }
+    m_treeModel->setChildNotesCounts(m_pendingFolderCounts, m_pendingTagCounts);
+    m_pendingFolderCounts.clear();
+    m_pendingTagCounts.clear();
 }
 
 void TreeViewLogic::openFolder(int id)
@@ -363,6 +410,19 @@ void TreeViewLogic::onMoveNodeRequested(int nodeId, int targetId)
     emit requestMoveNodeInDB(nodeId, target);
 }
 
+/*!
+ * \brief TreeViewLogic::onMoveNotesRequested
+ * Moves all notes in one database request, the target folder and notes
+ * already inside it are checked on the database side
+ */
+void TreeViewLogic::onMoveNotesRequested(const QSet<int> &noteIds, int targetId)
+{
+    if (noteIds.isEmpty()) {
+        return;
+    }
+    emit requestMoveNotesInDB(noteIds, targetId);
+}
+
 void TreeViewLogic::setTheme(Theme::Value theme)
 {
     m_treeView->setTheme(theme);
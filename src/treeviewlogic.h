@@ -2,6 +2,8 @@
 #define TREEVIEWLOGIC_H
 
 #include <QObject>
+#include <QHash>
+#include <QTimer>
 #include "dbmanager.h"
 #include "editorsettingsoptions.h"
 
@@ -19,8 +21,10 @@ public:
     explicit TreeViewLogic(NodeTreeView *treeView, NodeTreeModel *treeModel, DBManager *dbManager, NoteListView *listView, QObject *parent = nullptr);
     void openFolder(int id);
     void onMoveNodeRequested(int nodeId, int targetId);
+    void onMoveNotesRequested(const QSet<int> &noteIds, int targetId);
     void setTheme(Theme::Value theme);
     void setLastSavedState(bool isLastSelectFolder, const QString &lastSelectFolder, const QSet<int> &lastSelectTag, const QStringList &expandedFolder);
+    void loadTreeSnapshot(const NodeTagTreeData &treeData, int allNotesCount, int trashCount);
 private slots:
     void updateTreeViewSeparator();
     void loadTreeModel(const NodeTagTreeData &treeData);
@@ -31,18 +35,21 @@ private slots:
     void onChangeTagColorRequested(const QModelIndex &index);
     void onDeleteTagRequested(const QModelIndex &index);
     void onChildNotesCountChangedTag(int tagId, int notesCount);
-    void onChildNoteCountChangedFolder(int folderId, const QString &absPath, int notesCount);
+    void onChildNoteCountChangedFolder(int folderId, int notesCount);
 
 signals:
     void requestRenameNodeInDB(int id, const QString &newName);
     void requestRenameTagInDB(int id, const QString &newName);
     void requestChangeTagColorInDB(int id, const QString &newColor);
     void requestMoveNodeInDB(int id, const NodeData &target);
-    void addNoteToTag(int noteId, int tagId);
-    void noteMoved(int nodeId, int targetId);
+    void requestMoveNotesInDB(const QSet<int> &noteIds, int targetId);
+    void addNotesToTag(const QSet<int> &noteIds, int tagId);
+    void notesMoved(const QSet<int> &noteIds, int targetId);
 
 private:
     void onAddFolderRequested(bool fromPlusButton);
+    void setAllNotesAndTrashCount(int allNotesCount, int trashCount);
+    void applyPendingChildNotesCounts();
 
 private:
     NodeTreeView *m_treeView;
@@ -56,6 +63,9 @@ private:
     QString m_lastSelectFolder;
     QSet<int> m_lastSelectTags;
     QStringList m_expandedFolder;
+    QHash<int, int> m_pendingFolderCounts;
+    QHash<int, int> m_pendingTagCounts;
+    QTimer m_childNotesCountTimer;
 };
 
 #endif // TREEVIEWLOGIC_H
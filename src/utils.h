@@ -27,17 +27,18 @@ inline double gaussianDist(double x, double center, double sigma)
  */
 inline QString parseDateTime(const QDateTime &dateTime)
 {
-    QLocale usLocale(QLocale("en_US"));
+    static const QLocale usLocale(QLocale("en_US"));
 
     auto currDateTime = QDateTime::currentDateTime();
 
     if (dateTime.date() == currDateTime.date()) {
         return usLocale.toString(dateTime.time(), "h:mm A");
     }
-    if (dateTime.daysTo(currDateTime) == 1) {
+    auto daysTo = dateTime.daysTo(currDateTime);
+    if (daysTo == 1) {
         return "Yesterday";
     }
-    if (dateTime.daysTo(currDateTime) >= 2 && dateTime.daysTo(currDateTime) <= 7) {
+    if (daysTo >= 2 && daysTo <= 7) {
         return usLocale.toString(dateTime.date(), "dddd");
     }
 
@@ -4,7 +4,7 @@
 #
 #-------------------------------------------------
 
-QT       += widgets testlib network
+QT       += widgets testlib network sql
 
 TARGET    = test
 CONFIG   += testcase
@@ -22,13 +22,17 @@ HEADERS += \
     tst_mainwindow.h \
     tst_notedata.h \
     tst_notemodel.h \
-    tst_noteview.h
+    tst_noteview.h \
+    ../src/notelistmodel.h
 
 SOURCES += \
     main.cpp \
     tst_notedata.cpp \
     tst_mainwindow.cpp \
     tst_notemodel.cpp \
-    tst_noteview.cpp
+    tst_noteview.cpp \
+    ../src/nodedata.cpp \
+    ../src/nodepath.cpp \
+    ../src/notelistmodel.cpp
 
 DEFINES += SRCDIR=\\\"$$PWD\\\"
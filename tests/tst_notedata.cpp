@@ -7,10 +7,56 @@ tst_NoteData::tst_NoteData()
 
 void tst_NoteData::initTestCase()
 {
-
+    QString content(4096, QChar('x'));
+    for (int i = 0; i < 1000; ++i) {
+        NodeData note;
+        note.setId(i);
+        note.setFullTitle(QStringLiteral("Note %1").arg(i));
+        note.setContent(content);
+        note.setCreationDateTime(QDateTime::currentDateTime());
+        note.setLastModificationDateTime(QDateTime::currentDateTime());
+        note.setTagIds({ 1, 2, 3 });
+        m_notes.append(note);
+    }
 }
 
 void tst_NoteData::cleanupTestCase()
 {
+    m_notes.clear();
+}
+
+void tst_NoteData::copyDetachesOnWrite()
+{
+    NodeData a = m_notes.first();
+    NodeData b = a;
+    b.setFullTitle(QStringLiteral("changed"));
+    QCOMPARE(a.fullTitle(), m_notes.first().fullTitle());
+    QCOMPARE(b.fullTitle(), QStringLiteral("changed"));
+}
 
+void tst_NoteData::benchmarkCopyNoteList_data()
+{
+    QTest::addColumn<bool>("detach");
+    QTest::newRow("shared") << false;
+    QTest::newRow("detached") << true;
+}
+
+/*!
+ * \brief tst_NoteData::benchmarkCopyNoteList
+ * The detached row writes to every copy, so each one pays the field by field
+ * copy every note cost before NodeData became implicitly shared
+ */
+void tst_NoteData::benchmarkCopyNoteList()
+{
+    QFETCH(bool, detach);
+    QBENCHMARK {
+        QVector<NodeData> copies;
+        copies.reserve(m_notes.size());
+        for (const auto &note : std::as_const(m_notes)) {
+            copies.append(note);
+            if (detach) {
+                copies.last().setContent(note.content());
+            }
+        }
+    }
 }
@@ -2,7 +2,7 @@
 #define TST_NOTEDATA_H
 
 #include <QtTest>
-#include "../src/notedata.h"
+#include "../src/nodedata.h"
 
 class tst_NoteData : public QObject
 {
@@ -14,6 +14,12 @@ public:
 private Q_SLOTS:
     void initTestCase();
     void cleanupTestCase();
+    void copyDetachesOnWrite();
+    void benchmarkCopyNoteList_data();
+    void benchmarkCopyNoteList();
+
+private:
+    QVector<NodeData> m_notes;
 
 };
 
@@ -14,3 +14,67 @@ void tst_NoteModel::cleanupTestCase()
 {
 
 }
+
+/*!
+ * \brief tst_NoteModel::setListNoteKeepsIdIndexOnPinChange
+ * A tag view lists every note unpinned, a folder view splits out the pinned
+ * ones, so switching between them moves notes across the two sections
+ */
+void tst_NoteModel::setListNoteKeepsIdIndexOnPinChange()
+{
+    const QVector<int> ids{ 1, 2, 3, 4 };
+    QVector<NodeData> notes;
+    for (const auto id : ids) {
+        notes.append(createNote(id, id == 3));
+    }
+
+    NoteListModel model;
+    model.setListNote(notes, listViewInfo(true));
+    QVERIFY(!model.hasPinnedNote());
+    verifyIdIndex(model, ids);
+
+    model.setListNote(notes, listViewInfo(false));
+    QVERIFY(model.hasPinnedNote());
+    QCOMPARE(model.getNoteIndex(3).row(), 0);
+    verifyIdIndex(model, ids);
+
+    model.setListNote(notes, listViewInfo(true));
+    QVERIFY(!model.hasPinnedNote());
+    verifyIdIndex(model, ids);
+}
+
+NodeData tst_NoteModel::createNote(int id, bool isPinned)
+{
+    NodeData note;
+    note.setId(id);
+    note.setNodeType(NodeData::Type::Note);
+    note.setParentId(DEFAULT_NOTES_FOLDER_ID);
+    note.setFullTitle(QStringLiteral("Note %1").arg(id));
+    note.setLastModificationTime(id * 1000);
+    note.setCreationTime(id * 1000);
+    note.setIsPinnedNote(isPinned);
+    return note;
+}
+
+ListViewInfo tst_NoteModel::listViewInfo(bool isInTag)
+{
+    ListViewInfo inf;
+    inf.isInSearch = false;
+    inf.isInTag = isInTag;
+    inf.currentTagList = isInTag ? QSet<int>{ 1 } : QSet<int>{};
+    inf.parentFolderId = DEFAULT_NOTES_FOLDER_ID;
+    inf.currentNotesId = { INVALID_NODE_ID };
+    inf.needCreateNewNote = false;
+    inf.scrollToId = INVALID_NODE_ID;
+    return inf;
+}
+
+void tst_NoteModel::verifyIdIndex(const NoteListModel &model, const QVector<int> &ids)
+{
+    QCOMPARE(model.rowCount(), ids.size());
+    for (const auto id : ids) {
+        auto index = model.getNoteIndex(id);
+        QVERIFY2(index.isValid(), qPrintable(QStringLiteral("note %1 lost its index").arg(id)));
+        QCOMPARE(model.getNote(index).id(), id);
+    }
+}
@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QtTest>
+#include "../src/notelistmodel.h"
 
 class tst_NoteModel : public QObject
 {
@@ -13,6 +14,12 @@ public:
 private Q_SLOTS:
     void initTestCase();
     void cleanupTestCase();
+    void setListNoteKeepsIdIndexOnPinChange();
+
+private:
+    static NodeData createNote(int id, bool isPinned);
+    static ListViewInfo listViewInfo(bool isInTag);
+    static void verifyIdIndex(const NoteListModel &model, const QVector<int> &ids);
 };
 
 #endif // TST_NOTEMODEL_H